@@ -0,0 +1,99 @@
+#include "Utils.h"
+
+#include <SLabCoreLib/ObjectBuilder.h>
+#include <SLabCoreLib/SimulationParameters.h>
+#include <SLabCoreLib/Simulator/Common/SimulatorRegistry.h>
+#include <SLabCoreLib/StructuralMaterialDatabase.h>
+#include <SLabCoreLib/ThreadManager.h>
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+
+//
+// Runs ISimulator::Update on synthetic objects, for each registered simulator.
+//
+// Arguments: number of springs, simulation parallelism (0 == max)
+//
+
+static void Simulator_Update(benchmark::State & state, std::string const & simulatorName)
+{
+    size_t const numSprings = static_cast<size_t>(state.range(0));
+
+    static StructuralMaterialDatabase const structuralMaterialDatabase = StructuralMaterialDatabase::Load();
+
+    ThreadManager threadManager(true, ThreadManager::GetNumberOfProcessors());
+    if (state.range(1) != 0)
+    {
+        threadManager.SetSimulationParallelism(
+            std::min(static_cast<size_t>(state.range(1)), threadManager.GetMaxSimulationParallelism()));
+    }
+
+    Object object = ObjectBuilder::MakeSynthetic(
+        numSprings,
+        structuralMaterialDatabase,
+        SimulatorRegistry::GetLayoutOptimizer(simulatorName));
+
+    SimulationParameters simulationParameters;
+
+    std::unique_ptr<ISimulator> simulator = SimulatorRegistry::MakeSimulator(
+        simulatorName,
+        object,
+        simulationParameters,
+        threadManager);
+
+    float currentSimulationTime = 0.0f;
+
+    for (auto _ : state)
+    {
+        simulator->Update(
+            object,
+            currentSimulationTime,
+            simulationParameters,
+            threadManager);
+
+        currentSimulationTime += simulationParameters.Common.SimulationTimeStepDuration;
+
+        benchmark::ClobberMemory();
+    }
+
+    ElementCount const actualNumSprings = object.GetSprings().GetElementCount();
+
+    state.counters["Springs"] = static_cast<double>(actualNumSprings);
+    state.counters["Threads"] = static_cast<double>(threadManager.GetSimulationParallelism());
+    state.counters["Springs/s"] = benchmark::Counter(
+        static_cast<double>(actualNumSprings) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+}
+
+static void RegisterSimulatorBenchmarks()
+{
+    for (std::string const & simulatorName : SimulatorRegistry::GetSimulatorTypeNames())
+    {
+        benchmark::RegisterBenchmark(
+            ("Simulator_Update/" + simulatorName).c_str(),
+            Simulator_Update,
+            simulatorName)
+            ->ArgNames({ "springs", "threads" })
+            ->ArgsProduct({ { 1000, 10000, 100000, 1000000 }, { 1, 0 } })
+            ->Unit(benchmark::kMicrosecond)
+            ->UseRealTime();
+    }
+}
+
+// We provide our own main, as the simulator benchmarks may only be registered
+// once the SimulatorRegistry singleton has been statically initialized
+int main(int argc, char ** argv)
+{
+    RegisterSimulatorBenchmarks();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -6,9 +6,9 @@
 #define out varying
 
 // Inputs
-in vec4 inSpringAttributeGroup1; // Position, VertexSpacePosition
+in vec4 inSpringAttributeGroup1; // EndpointAIndex, EndpointBIndex, VertexSpacePosition
 in vec4 inSpringAttributeGroup2; // Color
-in float inSpringAttributeGroup3; // Highlight
+in vec2 inSpringAttributeGroup3; // HalfWorldThickness, Highlight
 
 // Outputs        
 out vec2 vertexSpacePosition;
@@ -17,14 +17,47 @@ out float springHighlight;
 
 // Params
 uniform mat4 paramOrthoMatrix;
+uniform sampler2D paramPointPositionsTexture; // Two points per texel
+uniform vec2 paramPointPositionsTextureSize; // In texels
+
+vec2 GetPointPosition(float pointIndex)
+{
+    float texelIndex = floor(pointIndex / 2.0);
+
+    vec2 texelCoords = vec2(
+        mod(texelIndex, paramPointPositionsTextureSize.x),
+        floor(texelIndex / paramPointPositionsTextureSize.x));
+
+    vec4 texel = texture2DLod(
+        paramPointPositionsTexture, 
+        (texelCoords + 0.5) / paramPointPositionsTextureSize, 
+        0.0);
+
+    return (pointIndex - 2.0 * texelIndex) < 0.5 ? texel.xy : texel.zw;
+}
 
 void main()
 {  
     vertexSpacePosition = inSpringAttributeGroup1.zw;
     springColor = inSpringAttributeGroup2;
-    springHighlight = inSpringAttributeGroup3;
+    springHighlight = inSpringAttributeGroup3.y;
+
+    vec2 endpointAPosition = GetPointPosition(inSpringAttributeGroup1.x);
+    vec2 endpointBPosition = GetPointPosition(inSpringAttributeGroup1.y);
+
+    vec2 springVector = endpointBPosition - endpointAPosition;
+    float springLength = length(springVector);
+    vec2 springNormal = springLength > 0.0
+        ? vec2(-springVector.y, springVector.x) / springLength * inSpringAttributeGroup3.x
+        : vec2(0.0);
+
+    // Bottom vertices sit on endpoint A, top vertices on endpoint B;
+    // left vertices are offset along -normal, right ones along +normal
+    vec2 vertexPosition = 
+        (vertexSpacePosition.y < 0.0 ? endpointAPosition : endpointBPosition)
+        + springNormal * vertexSpacePosition.x;
 
-    gl_Position = paramOrthoMatrix * vec4(inSpringAttributeGroup1.xy, -1.0, 1.0);
+    gl_Position = paramOrthoMatrix * vec4(vertexPosition, -1.0, 1.0);
 }
 
 ###FRAGMENT
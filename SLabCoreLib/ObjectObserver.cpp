@@ -0,0 +1,306 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ObjectObserver.h"
+
+#include "SysSpecifics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+ObjectObserver::ObjectObserver()
+    : mTaskStates()
+    , mReductionTasks()
+    , mCurrentObject(nullptr)
+{
+}
+
+ObjectObserver::Observation ObjectObserver::Observe(
+    Object const & object,
+    ISimulator const & simulator,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Energies
+    //
+
+    std::optional<ObjectEnergies> energies = simulator.GetLastUpdateEnergies();
+    if (!energies)
+    {
+        energies.emplace(CalculateEnergies(object, simulationParameters, threadManager));
+    }
+
+    //
+    // Bending
+    //
+
+    std::optional<float> bending;
+
+    auto const & bendingProbe = object.GetPoints().GetBendingProbe();
+    if (bendingProbe)
+    {
+        vec2f const & currentProbePosition = object.GetPoints().GetPosition(bendingProbe->PointIndex);
+
+        // TODOHERE: arc?
+        bending = -(currentProbePosition.y - bendingProbe->OriginalWorldCoordinates.y);
+    }
+
+    return Observation(
+        energies->TotalKineticEnergy,
+        energies->TotalPotentialEnergy,
+        bending);
+}
+
+ObjectEnergies ObjectObserver::CalculateEnergies(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Split points and springs among tasks
+    //
+    // Point ranges start at multiples of the vectorization word and, but for the last one,
+    // are made of whole cache lines; the last one extends to the end of the point buffers,
+    // whose padding has zero mass and velocity. Spring ranges start at multiples of the
+    // vectorization word, too, but the last one ends at the last spring, as the endpoints
+    // of padding springs are not valid point indices.
+    //
+
+    ElementCount const pointCount = object.GetPoints().GetBufferElementCount();
+    ElementCount const springCount = object.GetSprings().GetElementCount();
+
+    // Below this many springs per task, a task isn't worth its dispatching
+    ElementCount constexpr MinSpringsPerTask = 4096;
+
+    size_t const parallelism = std::max(
+        std::min(
+            threadManager.GetSimulationParallelism(),
+            static_cast<size_t>(springCount / MinSpringsPerTask)),
+        size_t(1));
+
+    ElementCount constexpr PointGranularity = 16;
+    ElementCount const numberOfPointsPerTask =
+        (pointCount / static_cast<ElementCount>(parallelism) + PointGranularity - 1) / PointGranularity * PointGranularity;
+
+    ElementCount constexpr SpringGranularity = vectorization_float_count<ElementCount>;
+    ElementCount const numberOfSpringsPerTask =
+        (springCount / static_cast<ElementCount>(parallelism) + SpringGranularity - 1) / SpringGranularity * SpringGranularity;
+
+    mTaskStates.clear();
+    mReductionTasks.clear();
+
+    ElementIndex pointStart = 0;
+    ElementIndex springStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const pointEnd = (t < parallelism - 1)
+            ? std::min(pointStart + numberOfPointsPerTask, pointCount)
+            : pointCount;
+
+        ElementIndex const springEnd = (t < parallelism - 1)
+            ? std::min(springStart + numberOfSpringsPerTask, springCount)
+            : springCount;
+
+        mTaskStates.emplace_back(pointStart, pointEnd, springStart, springEnd);
+
+        mReductionTasks.emplace_back(
+            [this, t]()
+            {
+                RunReductionTask(t);
+            });
+
+        pointStart = pointEnd;
+        springStart = springEnd;
+    }
+
+    //
+    // Reduce
+    //
+
+    mCurrentObject = &object;
+
+    if (mReductionTasks.size() == 1)
+    {
+        // Spare ourselves the pool
+        RunReductionTask(0);
+    }
+    else
+    {
+        threadManager.GetSimulationThreadPool().Run(mReductionTasks);
+    }
+
+    mCurrentObject = nullptr;
+
+    float totalKineticEnergy = 0.0f;
+    float totalPotentialEnergy = 0.0f;
+    for (auto const & taskState : mTaskStates)
+    {
+        totalKineticEnergy += taskState.KineticEnergy;
+        totalPotentialEnergy += taskState.PotentialEnergy;
+    }
+
+    // TODOHERE: we can only do this ourselves if MaterialStiffness is all that there is
+    totalPotentialEnergy *= simulationParameters.ClassicSimulator.SpringStiffnessCoefficient;
+
+    return ObjectEnergies(
+        totalKineticEnergy * 0.5f,
+        totalPotentialEnergy * 0.5f);
+}
+
+void ObjectObserver::RunReductionTask(size_t taskIndex)
+{
+    assert(mCurrentObject != nullptr);
+
+    TaskState & taskState = mTaskStates[taskIndex];
+
+    taskState.KineticEnergy = CalculateKineticEnergyVectorized(
+        *mCurrentObject,
+        taskState.StartPointIndex,
+        taskState.EndPointIndex);
+
+    taskState.PotentialEnergy = CalculatePotentialEnergyVectorized(
+        *mCurrentObject,
+        taskState.StartSpringIndex,
+        taskState.EndSpringIndex);
+}
+
+float ObjectObserver::CalculateKineticEnergyVectorized(
+    Object const & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    // This implementation is for 4-float SSE
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    assert(is_aligned_to_float_element_count(startPointIndex));
+    assert(is_aligned_to_float_element_count(endPointIndex));
+
+    vec2f const * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+    float const * restrict const pointMassBuffer = object.GetPoints().GetMassBuffer();
+
+    __m128 sum = _mm_setzero_ps();
+
+    for (ElementIndex p = startPointIndex; p < endPointIndex; p += 4)
+    {
+        // m0 m1 m2 m3
+        __m128 const m = _mm_load_ps(pointMassBuffer + p);
+
+        // v0_x v0_y v1_x v1_y
+        __m128 const v01 = _mm_load_ps(reinterpret_cast<float const *>(pointVelocityBuffer + p));
+        // v2_x v2_y v3_x v3_y
+        __m128 const v23 = _mm_load_ps(reinterpret_cast<float const *>(pointVelocityBuffer + p + 2));
+
+        sum = _mm_add_ps(
+            sum,
+            _mm_mul_ps(
+                _mm_mul_ps(v01, v01),
+                _mm_unpacklo_ps(m, m))); // m0 m0 m1 m1
+
+        sum = _mm_add_ps(
+            sum,
+            _mm_mul_ps(
+                _mm_mul_ps(v23, v23),
+                _mm_unpackhi_ps(m, m))); // m2 m2 m3 m3
+    }
+
+    aligned_to_vword float partialSums[4];
+    _mm_store_ps(partialSums, sum);
+
+    return (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+}
+
+float ObjectObserver::CalculatePotentialEnergyVectorized(
+    Object const & object,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
+{
+    // This implementation is for 4-float SSE
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+
+    Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+    float const * restrict const materialStiffnessBuffer = object.GetSprings().GetMaterialStiffnessBuffer();
+
+    __m128 const SignMask = _mm_set1_ps(-0.0f);
+
+    __m128 sum = _mm_setzero_ps();
+
+    ElementIndex s = startSpringIndex;
+
+    for (; s + 4 <= endSpringIndex; s += 4)
+    {
+        // ?_pos_x
+        // ?_pos_y
+        // *
+        // *
+        __m128 const s0_a_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 0].PointAIndex)));
+        __m128 const s1_a_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 1].PointAIndex)));
+        __m128 const s2_a_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 2].PointAIndex)));
+        __m128 const s3_a_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 3].PointAIndex)));
+        __m128 const s0_b_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 0].PointBIndex)));
+        __m128 const s1_b_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 1].PointBIndex)));
+        __m128 const s2_b_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 2].PointBIndex)));
+        __m128 const s3_b_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + endpointsBuffer[s + 3].PointBIndex)));
+
+        __m128 const s0s1_dis_xy = _mm_sub_ps(
+            _mm_movelh_ps(s0_b_pos_xy, s1_b_pos_xy), // First argument goes low
+            _mm_movelh_ps(s0_a_pos_xy, s1_a_pos_xy));
+        __m128 const s2s3_dis_xy = _mm_sub_ps(
+            _mm_movelh_ps(s2_b_pos_xy, s3_b_pos_xy),
+            _mm_movelh_ps(s2_a_pos_xy, s3_a_pos_xy));
+
+        // Shuffle:
+        //
+        // s0_dis_x     s0_dis_y
+        // s1_dis_x     s1_dis_y
+        // s2_dis_x     s2_dis_y
+        // s3_dis_x     s3_dis_y
+        __m128 const s0s1s2s3_dis_x = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0x88);
+        __m128 const s0s1s2s3_dis_y = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0xDD);
+
+        // Calculate spring lengths: sqrt( x*x + y*y ); we don't want the approximated
+        // reciprocals here, as each error would end up in the sum
+        __m128 const s0s1s2s3_springLength = _mm_sqrt_ps(
+            _mm_add_ps(
+                _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_dis_x),
+                _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_dis_y)));
+
+        // | springLength[s] - restLength[s] | * materialStiffness[s]
+        __m128 const s0s1s2s3_energy = _mm_mul_ps(
+            _mm_andnot_ps( // Clear sign bit
+                SignMask,
+                _mm_sub_ps(
+                    s0s1s2s3_springLength,
+                    _mm_loadu_ps(restLengthBuffer + s))),
+            _mm_loadu_ps(materialStiffnessBuffer + s));
+
+        sum = _mm_add_ps(sum, s0s1s2s3_energy);
+    }
+
+    aligned_to_vword float partialSums[4];
+    _mm_store_ps(partialSums, sum);
+
+    float result = (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+
+    // Leftovers
+    for (; s < endSpringIndex; ++s)
+    {
+        float const springLength = (pointPositionBuffer[endpointsBuffer[s].PointBIndex] - pointPositionBuffer[endpointsBuffer[s].PointAIndex]).length();
+
+        result += std::abs(springLength - restLengthBuffer[s]) * materialStiffnessBuffer[s];
+    }
+
+    return result;
+}
@@ -0,0 +1,106 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Object.h"
+#include "SimulationParameters.h"
+#include "SLabTypes.h"
+#include "ThreadManager.h"
+
+#include "Simulator/Common/ISimulator.h"
+
+#include <optional>
+#include <vector>
+
+/*
+ * This class calculates the observable physics of an object - its total energies
+ * and its bending.
+ *
+ * Energies are taken from the simulator when it has accumulated them during its last
+ * update; otherwise, they are reduced over the whole object, splitting points and springs
+ * among the simulation threads, each reducing its own ranges four elements at a time.
+ */
+class ObjectObserver final
+{
+public:
+
+    struct Observation
+    {
+        float TotalKineticEnergy;
+        float TotalPotentialEnergy;
+        std::optional<float> Bending;
+
+        Observation(
+            float totalKineticEnergy,
+            float totalPotentialEnergy,
+            std::optional<float> bending)
+            : TotalKineticEnergy(totalKineticEnergy)
+            , TotalPotentialEnergy(totalPotentialEnergy)
+            , Bending(bending)
+        {}
+    };
+
+    ObjectObserver();
+
+    Observation Observe(
+        Object const & object,
+        ISimulator const & simulator,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager);
+
+private:
+
+    ObjectEnergies CalculateEnergies(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager);
+
+    void RunReductionTask(size_t taskIndex);
+
+    // Returns the sum of mass * velocity^2
+    static float CalculateKineticEnergyVectorized(
+        Object const & object,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex); // Excluded
+
+    // Returns the sum of material stiffness * |length - rest length|
+    static float CalculatePotentialEnergyVectorized(
+        Object const & object,
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex); // Excluded
+
+private:
+
+    struct alignas(64) TaskState // Own cache line, as partial sums are written concurrently
+    {
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndex; // Excluded
+
+        float KineticEnergy;
+        float PotentialEnergy;
+
+        TaskState(
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex,
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndex)
+            : StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+            , StartSpringIndex(startSpringIndex)
+            , EndSpringIndex(endSpringIndex)
+            , KineticEnergy(0.0f)
+            , PotentialEnergy(0.0f)
+        {}
+    };
+
+    std::vector<TaskState> mTaskStates;
+    std::vector<typename ThreadPool::Task> mReductionTasks;
+
+    // Current observation's object
+    Object const * mCurrentObject;
+};
@@ -0,0 +1,148 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "PointSpatialIndex.h"
+
+#include "AABB.h"
+
+#include <cassert>
+#include <cmath>
+
+PointSpatialIndex::PointSpatialIndex()
+    : mOrigin(vec2f::zero())
+    , mCellSizeInv(0.0f)
+    , mColumnCount(1)
+    , mRowCount(1)
+    , mCellStarts(2, 0)
+    , mEntries()
+    , mPointCells()
+{
+}
+
+void PointSpatialIndex::Rebuild(Points const & points)
+{
+    ElementCount const pointCount = points.GetElementCount();
+    vec2f const * const positionBuffer = points.GetPositionBuffer();
+
+    //
+    // Lay out grid
+    //
+
+    AABB const aabb = points.GetAABB();
+    float const width = aabb.TopRight.x - aabb.BottomLeft.x;
+    float const height = aabb.TopRight.y - aabb.BottomLeft.y;
+
+    // About one point per cell, were points evenly spread; the second term caps
+    // the number of cells for objects that are (almost) a line
+    float const cellSize = (pointCount > 0)
+        ? std::max(
+            std::sqrt(width * height / static_cast<float>(pointCount)),
+            std::max(width, height) / static_cast<float>(pointCount))
+        : 0.0f;
+
+    if (std::isfinite(cellSize) && cellSize > 0.0f)
+    {
+        mOrigin = aabb.BottomLeft;
+        mCellSizeInv = 1.0f / cellSize;
+        mColumnCount = static_cast<int>(width * mCellSizeInv) + 1;
+        mRowCount = static_cast<int>(height * mCellSizeInv) + 1;
+    }
+    else
+    {
+        // No points, coinciding points, or positions gone wild: one cell for all
+        mOrigin = vec2f::zero();
+        mCellSizeInv = 0.0f;
+        mColumnCount = 1;
+        mRowCount = 1;
+    }
+
+    size_t const cellCount = static_cast<size_t>(mColumnCount) * static_cast<size_t>(mRowCount);
+
+    //
+    // Counting sort
+    //
+
+    // 1. Count points in each cell, shifted by one
+
+    mCellStarts.assign(cellCount + 1, 0);
+    mPointCells.resize(pointCount);
+
+    for (ElementIndex p = 0; p < pointCount; ++p)
+    {
+        ElementIndex const c =
+            static_cast<ElementIndex>(GetRow(positionBuffer[p].y)) * static_cast<ElementIndex>(mColumnCount)
+            + static_cast<ElementIndex>(GetColumn(positionBuffer[p].x));
+
+        mPointCells[p] = c;
+        ++mCellStarts[c + 1];
+    }
+
+    // 2. Turn counts into starts
+
+    for (size_t c = 0; c < cellCount; ++c)
+    {
+        mCellStarts[c + 1] += mCellStarts[c];
+    }
+
+    assert(mCellStarts[cellCount] == pointCount);
+
+    // 3. Scatter, using starts as cursors; at the end, each start
+    //    has moved to the start of the next cell
+
+    mEntries.resize(pointCount);
+
+    for (ElementIndex p = 0; p < pointCount; ++p)
+    {
+        mEntries[mCellStarts[mPointCells[p]]++] = Entry(positionBuffer[p], p);
+    }
+
+    // 4. Shift starts back
+
+    for (size_t c = cellCount; c > 0; --c)
+    {
+        mCellStarts[c] = mCellStarts[c - 1];
+    }
+
+    mCellStarts[0] = 0;
+}
+
+std::optional<ElementIndex> PointSpatialIndex::FindNearestPoint(
+    vec2f const & position,
+    float radius) const
+{
+    float bestSquareDistance = radius * radius;
+    ElementIndex bestPoint = NoneElementIndex;
+
+    int const startRow = GetRow(position.y - radius);
+    int const endRow = GetRow(position.y + radius); // Included
+    int const startColumn = GetColumn(position.x - radius);
+    int const endColumn = GetColumn(position.x + radius); // Included
+
+    for (int r = startRow; r <= endRow; ++r)
+    {
+        for (int c = startColumn; c <= endColumn; ++c)
+        {
+            size_t const cell = static_cast<size_t>(r) * static_cast<size_t>(mColumnCount) + static_cast<size_t>(c);
+
+            for (ElementIndex e = mCellStarts[cell]; e < mCellStarts[cell + 1]; ++e)
+            {
+                float const squareDistance = (mEntries[e].Position - position).squareLength();
+
+                // On ties, prefer the lowest index, as a scan of all points would
+                if (squareDistance < bestSquareDistance
+                    || (squareDistance == bestSquareDistance && bestPoint != NoneElementIndex && mEntries[e].PointIndex < bestPoint))
+                {
+                    bestSquareDistance = squareDistance;
+                    bestPoint = mEntries[e].PointIndex;
+                }
+            }
+        }
+    }
+
+    if (bestPoint != NoneElementIndex)
+        return bestPoint;
+    else
+        return std::nullopt;
+}
@@ -0,0 +1,79 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Points.h"
+#include "SLabTypes.h"
+#include "Vectors.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+/*
+ * A uniform grid over the positions of the points of an object, for finding the
+ * point nearest to a position within a radius without visiting all points.
+ *
+ * Cells are sized after the density of the object, so that each holds a handful of
+ * points; points are bucketed into cells with a counting sort, which makes building
+ * linear in the number of points. The index is a snapshot: it has to be rebuilt
+ * whenever positions change.
+ */
+class PointSpatialIndex final
+{
+public:
+
+    PointSpatialIndex();
+
+    void Rebuild(Points const & points);
+
+    std::optional<ElementIndex> FindNearestPoint(
+        vec2f const & position,
+        float radius) const;
+
+private:
+
+    int GetColumn(float x) const
+    {
+        // Written so that NaN's land in the first column and infinities in the extreme ones
+        return static_cast<int>(std::min(std::max(0.0f, (x - mOrigin.x) * mCellSizeInv), static_cast<float>(mColumnCount - 1)));
+    }
+
+    int GetRow(float y) const
+    {
+        return static_cast<int>(std::min(std::max(0.0f, (y - mOrigin.y) * mCellSizeInv), static_cast<float>(mRowCount - 1)));
+    }
+
+private:
+
+    struct Entry
+    {
+        vec2f Position;
+        ElementIndex PointIndex;
+
+        Entry() = default;
+
+        Entry(
+            vec2f const & position,
+            ElementIndex pointIndex)
+            : Position(position)
+            , PointIndex(pointIndex)
+        {}
+    };
+
+    // Grid geometry
+    vec2f mOrigin;
+    float mCellSizeInv;
+    int mColumnCount;
+    int mRowCount;
+
+    // Entries of cell c are at [mCellStarts[c], mCellStarts[c + 1]); cells are row-major
+    std::vector<ElementIndex> mCellStarts;
+    std::vector<Entry> mEntries;
+
+    // Cell of each point, only used while rebuilding
+    std::vector<ElementIndex> mPointCells;
+};
@@ -212,6 +212,11 @@ public:
         return mMassBuffer[pointElementIndex];
     }
 
+    float const * GetMassBuffer() const noexcept
+    {
+        return mMassBuffer.data();
+    }
+
     bool GetFrozenCoefficient(ElementIndex pointElementIndex) const
     {
         return mFrozenCoefficientBuffer[pointElementIndex];
@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #include "RenderContext.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 
 RenderContext::RenderContext(
@@ -68,6 +70,8 @@ RenderContext::RenderContext(
     // Springs
     //
 
+    mSpringVertexCount = 0;
+
     glGenVertexArrays(1, &tmpGLuint);
     mSpringVAO = tmpGLuint;
     glBindVertexArray(*mSpringVAO);
@@ -81,10 +85,37 @@ RenderContext::RenderContext(
     glEnableVertexAttribArray(static_cast<GLuint>(ShaderManager::VertexAttributeType::SpringAttributeGroup2));
     glVertexAttribPointer(static_cast<GLuint>(ShaderManager::VertexAttributeType::SpringAttributeGroup2), 4, GL_FLOAT, GL_FALSE, sizeof(SpringVertex), (void *)(4 * sizeof(float)));
     glEnableVertexAttribArray(static_cast<GLuint>(ShaderManager::VertexAttributeType::SpringAttributeGroup3));
-    glVertexAttribPointer(static_cast<GLuint>(ShaderManager::VertexAttributeType::SpringAttributeGroup3), 1, GL_FLOAT, GL_FALSE, sizeof(SpringVertex), (void *)(8 * sizeof(float)));
+    glVertexAttribPointer(static_cast<GLuint>(ShaderManager::VertexAttributeType::SpringAttributeGroup3), 2, GL_FLOAT, GL_FALSE, sizeof(SpringVertex), (void *)(8 * sizeof(float)));
+    static_assert(sizeof(SpringVertex) == 10 * sizeof(float));
 
     glBindVertexArray(0);
 
+    //
+    // Point positions texture
+    //
+
+    assert(PointPositionsTextureWidth <= SLabOpenGL::MaxTextureSize);
+
+    glGenTextures(1, &tmpGLuint);
+    mPointPositionsTexture = tmpGLuint;
+    mPointPositionsTextureHeight = 0;
+
+    // We only use texture unit 0
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, *mPointPositionsTexture);
+
+    // Texels are fetched exactly, and never mipmapped
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    CheckOpenGLError();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    mShaderManager->ActivateProgram<ShaderManager::ProgramType::Springs>();
+    mShaderManager->SetTextureParameter<ShaderManager::ProgramType::Springs, ShaderManager::ProgramParameterType::PointPositionsTexture>(0);
+
     //
     // Grid
     //
@@ -173,7 +204,7 @@ void RenderContext::RenderStart()
     glClearColor(ClearColor.x, ClearColor.y, ClearColor.z, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // Reset all buffers
+    // Reset all buffers - spring structure persists across frames
     mPointVertexCount = 0;
 
     // Process setting changes
@@ -286,89 +317,164 @@ void RenderContext::UploadPoints(
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void RenderContext::UploadSpringsStart(size_t springCount)
+void RenderContext::UploadSpringStructure(
+    size_t springCount,
+    Springs::Endpoints const * springEndpoints,
+    vec4f const * springColors,
+    float const * springNormThicknesses,
+    float const * springHighlights)
 {
     //
-    // Prepare buffer
+    // Build vertices - the actual positions are calculated by the vertex shader
+    // from the positions of the endpoints, which are uploaded at each frame
     //
 
-    mSpringVertexBuffer.clear();
-    mSpringVertexBuffer.reserve(springCount * 6);
-}
+    std::vector<SpringVertex> vertexBuffer;
+    vertexBuffer.reserve(springCount * 6);
 
-void RenderContext::UploadSpring(
-    vec2f const & springEndpointAPosition,
-    vec2f const & springEndpointBPosition,
-    vec4f const & springColor,
-    float springNormThickness,
-    float springHighlight)
-{
     float constexpr WorldThickness = 0.1f;
 
-    vec2f const springVector = springEndpointBPosition - springEndpointAPosition;
-    vec2f const springNormal = springVector.to_perpendicular().normalise()
-        * springNormThickness * WorldThickness / 2.0f;
-
-    vec2f const bottomLeft = springEndpointAPosition - springNormal;
-    vec2f const bottomRight = springEndpointAPosition + springNormal;
-    vec2f const topLeft = springEndpointBPosition - springNormal;
-    vec2f const topRight = springEndpointBPosition + springNormal;
-
-    // Left, bottom
-    mSpringVertexBuffer.emplace_back(
-        bottomLeft,
-        vec2f(-1.0f, -1.0f),
-        springColor,
-        springHighlight);
-
-    // Left, top
-    mSpringVertexBuffer.emplace_back(
-        topLeft,
-        vec2f(-1.0f, 1.0f),
-        springColor,
-        springHighlight);
-
-    // Right, bottom
-    mSpringVertexBuffer.emplace_back(
-        bottomRight,
-        vec2f(1.0f, -1.0f),
-        springColor,
-        springHighlight);
-
-    // Left, top
-    mSpringVertexBuffer.emplace_back(
-        topLeft,
-        vec2f(-1.0f, 1.0f),
-        springColor,
-        springHighlight);
-
-    // Right, bottom
-    mSpringVertexBuffer.emplace_back(
-        bottomRight,
-        vec2f(1.0f, -1.0f),
-        springColor,
-        springHighlight);
-
-    // Right, top
-    mSpringVertexBuffer.emplace_back(
-        topRight,
-        vec2f(1.0f, 1.0f),
-        springColor,
-        springHighlight);
+    for (size_t s = 0; s < springCount; ++s)
+    {
+        // Point indices travel as floats, which represent them exactly up to 2^24
+        assert(springEndpoints[s].PointAIndex <= (1u << 24) && springEndpoints[s].PointBIndex <= (1u << 24));
+
+        float const endpointAIndex = static_cast<float>(springEndpoints[s].PointAIndex);
+        float const endpointBIndex = static_cast<float>(springEndpoints[s].PointBIndex);
+        vec4f const & springColor = springColors[s];
+        float const halfWorldThickness = springNormThicknesses[s] * WorldThickness / 2.0f;
+        float const springHighlight = springHighlights[s];
+
+        // Left, bottom
+        vertexBuffer.emplace_back(
+            endpointAIndex,
+            endpointBIndex,
+            vec2f(-1.0f, -1.0f),
+            springColor,
+            halfWorldThickness,
+            springHighlight);
+
+        // Left, top
+        vertexBuffer.emplace_back(
+            endpointAIndex,
+            endpointBIndex,
+            vec2f(-1.0f, 1.0f),
+            springColor,
+            halfWorldThickness,
+            springHighlight);
+
+        // Right, bottom
+        vertexBuffer.emplace_back(
+            endpointAIndex,
+            endpointBIndex,
+            vec2f(1.0f, -1.0f),
+            springColor,
+            halfWorldThickness,
+            springHighlight);
+
+        // Left, top
+        vertexBuffer.emplace_back(
+            endpointAIndex,
+            endpointBIndex,
+            vec2f(-1.0f, 1.0f),
+            springColor,
+            halfWorldThickness,
+            springHighlight);
+
+        // Right, bottom
+        vertexBuffer.emplace_back(
+            endpointAIndex,
+            endpointBIndex,
+            vec2f(1.0f, -1.0f),
+            springColor,
+            halfWorldThickness,
+            springHighlight);
+
+        // Right, top
+        vertexBuffer.emplace_back(
+            endpointAIndex,
+            endpointBIndex,
+            vec2f(1.0f, 1.0f),
+            springColor,
+            halfWorldThickness,
+            springHighlight);
+    }
+
+    //
+    // Upload vertices
+    //
+
+    mSpringVertexCount = vertexBuffer.size();
+
+    glBindBuffer(GL_ARRAY_BUFFER, *mSpringVertexVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexBuffer.size() * sizeof(SpringVertex), vertexBuffer.data(), GL_STATIC_DRAW);
+    CheckOpenGLError();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void RenderContext::UploadSpringsEnd()
+void RenderContext::UploadPointPositions(
+    size_t pointCount,
+    vec2f const * pointPositions)
 {
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+
+    size_t constexpr PointsPerRow = PointPositionsTextureWidth * 2;
+
+    glBindTexture(GL_TEXTURE_2D, *mPointPositionsTexture);
+
     //
-    // Upload buffer, if needed
+    // Check whether we need to re-allocate the texture
     //
 
-    if (!mSpringVertexBuffer.empty())
+    GLsizei const textureHeight = std::max(
+        static_cast<GLsizei>((pointCount + PointsPerRow - 1) / PointsPerRow),
+        GLsizei(1));
+
+    if (textureHeight != mPointPositionsTextureHeight)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, *mSpringVertexVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(SpringVertex) * mSpringVertexBuffer.size(), mSpringVertexBuffer.data(), GL_STREAM_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (textureHeight > SLabOpenGL::MaxTextureSize)
+        {
+            throw SLabException("The object has too many points for this graphics driver");
+        }
+
+        mPointPositionsTextureHeight = textureHeight;
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, PointPositionsTextureWidth, mPointPositionsTextureHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
+        CheckOpenGLError();
+
+        mShaderManager->ActivateProgram<ShaderManager::ProgramType::Springs>();
+        mShaderManager->SetProgramParameter<ShaderManager::ProgramType::Springs, ShaderManager::ProgramParameterType::PointPositionsTextureSize>(
+            static_cast<float>(PointPositionsTextureWidth),
+            static_cast<float>(mPointPositionsTextureHeight));
     }
+
+    //
+    // Upload positions - full rows first, then the whole texels of the last row,
+    // and finally the odd point, if any, without reading past the end of the buffer
+    //
+
+    GLsizei const fullRowCount = static_cast<GLsizei>(pointCount / PointsPerRow);
+    if (fullRowCount > 0)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PointPositionsTextureWidth, fullRowCount, GL_RGBA, GL_FLOAT, pointPositions);
+    }
+
+    size_t const lastRowPointCount = pointCount - fullRowCount * PointsPerRow;
+    GLsizei const lastRowWholeTexelCount = static_cast<GLsizei>(lastRowPointCount / 2);
+    if (lastRowWholeTexelCount > 0)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, fullRowCount, lastRowWholeTexelCount, 1, GL_RGBA, GL_FLOAT, pointPositions + fullRowCount * PointsPerRow);
+    }
+
+    if ((lastRowPointCount % 2) != 0)
+    {
+        vec2f const lastTexel[2] = { pointPositions[pointCount - 1], vec2f::zero() };
+        glTexSubImage2D(GL_TEXTURE_2D, 0, lastRowWholeTexelCount, fullRowCount, 1, 1, GL_RGBA, GL_FLOAT, lastTexel);
+    }
+
+    CheckOpenGLError();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void RenderContext::RenderEnd()
@@ -377,17 +483,21 @@ void RenderContext::RenderEnd()
     // Render springs
     ////////////////////////////////////////////////////////////////
 
-    if (!mSpringVertexBuffer.empty())
+    if (mSpringVertexCount > 0)
     {
         glBindVertexArray(*mSpringVAO);
 
+        glBindTexture(GL_TEXTURE_2D, *mPointPositionsTexture);
+
         mShaderManager->ActivateProgram<ShaderManager::ProgramType::Springs>();
 
-        assert((mSpringVertexBuffer.size() % 6) == 0);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mSpringVertexBuffer.size()));
+        assert((mSpringVertexCount % 6) == 0);
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mSpringVertexCount));
 
         CheckOpenGLError();
 
+        glBindTexture(GL_TEXTURE_2D, 0);
+
         glBindVertexArray(0);
     }
 
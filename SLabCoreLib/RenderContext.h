@@ -9,6 +9,7 @@
 #include "ShaderManager.h"
 #include "SLabOpenGL.h"
 #include "SLabOpenGLMappedBuffer.h"
+#include "Springs.h"
 #include "Vectors.h"
 #include "ViewModel.h"
 
@@ -152,16 +153,23 @@ public:
         float const * pointHighlights,
         float const * pointFrozenCoefficients);
 
-    void UploadSpringsStart(size_t springCount);
-
-    void UploadSpring(
-        vec2f const & springEndpointAPosition,
-        vec2f const & springEndpointBPosition,
-        vec4f const & springColor,
-        float springNormThickness,
-        float springHighlight);
-
-    void UploadSpringsEnd();
+    /*
+     * Uploads the static attributes of the springs; only needs to be invoked when the
+     * object - or the render attributes of its springs - change.
+     */
+    void UploadSpringStructure(
+        size_t springCount,
+        Springs::Endpoints const * springEndpoints,
+        vec4f const * springColors,
+        float const * springNormThicknesses,
+        float const * springHighlights);
+
+    /*
+     * Uploads the positions of the points, from which springs are expanded on the GPU.
+     */
+    void UploadPointPositions(
+        size_t pointCount,
+        vec2f const * pointPositions);
 
     void RenderEnd();
 
@@ -235,30 +243,43 @@ private:
 
     struct SpringVertex
     {
-        vec2f Position;
+        float EndpointAIndex;
+        float EndpointBIndex;
         vec2f VertexSpacePosition;
         vec4f Color;
+        float HalfWorldThickness;
         float Highlight;
 
         SpringVertex(
-            vec2f const & position,
+            float endpointAIndex,
+            float endpointBIndex,
             vec2f const & vertexSpacePosition,
             vec4f const & color,
+            float halfWorldThickness,
             float highlight)
-            : Position(position)
+            : EndpointAIndex(endpointAIndex)
+            , EndpointBIndex(endpointBIndex)
             , VertexSpacePosition(vertexSpacePosition)
             , Color(color)
+            , HalfWorldThickness(halfWorldThickness)
             , Highlight(highlight)
         {}
     };
 
 #pragma pack(pop)
 
+    size_t mSpringVertexCount;
+
     SLabOpenGLVAO mSpringVAO;
 
-    std::vector<SpringVertex> mSpringVertexBuffer;
     SLabOpenGLVBO mSpringVertexVBO;
 
+    // Point positions, two points per (RGBA) texel; rows are PointPositionsTextureWidth
+    // texels wide, a power of two, so that the shader's index arithmetic is exact
+    static GLsizei constexpr PointPositionsTextureWidth = 1024;
+    SLabOpenGLTexture mPointPositionsTexture;
+    GLsizei mPointPositionsTextureHeight;
+
     ////////////////////////////////////////////////////////////////
     // Grid
     ////////////////////////////////////////////////////////////////
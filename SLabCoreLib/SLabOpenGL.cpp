@@ -12,6 +12,7 @@
 #include <numeric>
 
 int SLabOpenGL::MaxVertexAttributes = 0;
+int SLabOpenGL::MaxVertexTextureImageUnits = 0;
 int SLabOpenGL::MaxViewportWidth = 0;
 int SLabOpenGL::MaxViewportHeight = 0;
 int SLabOpenGL::MaxTextureSize = 0;
@@ -59,6 +60,15 @@ void SLabOpenGL::InitOpenGL()
     MaxVertexAttributes = tmpConstant;
     LogMessage("GL_MAX_VERTEX_ATTRIBS=", MaxVertexAttributes);
 
+    glGetIntegerv(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &tmpConstant);
+    MaxVertexTextureImageUnits = tmpConstant;
+    LogMessage("GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS=", MaxVertexTextureImageUnits);
+
+    if (MaxVertexTextureImageUnits < 1)
+    {
+        throw SLabException("We are sorry, but this game requires texture access from vertex shaders, which your graphics driver does not support");
+    }
+
     GLint maxViewportDims[2];
     glGetIntegerv(GL_MAX_VIEWPORT_DIMS, &(maxViewportDims[0]));
     MaxViewportWidth = maxViewportDims[0];
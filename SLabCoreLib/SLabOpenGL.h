@@ -189,6 +189,7 @@ public:
 public:
 
     static int MaxVertexAttributes;
+    static int MaxVertexTextureImageUnits;
     static int MaxViewportWidth;
     static int MaxViewportHeight;
     static int MaxTextureSize;
@@ -496,6 +496,10 @@ ShaderManager::ProgramParameterType ShaderManager::StrToProgramParameterType(std
         return ProgramParameterType::PixelWorldWidth;
     else if (str == "WorldStep")
         return ProgramParameterType::WorldStep;
+    else if (str == "PointPositionsTexture")
+        return ProgramParameterType::PointPositionsTexture;
+    else if (str == "PointPositionsTextureSize")
+        return ProgramParameterType::PointPositionsTextureSize;
     else
         throw SLabException("Unrecognized program parameter \"" + str + "\"");
 }
@@ -510,6 +514,10 @@ std::string ShaderManager::ProgramParameterTypeToStr(ProgramParameterType progra
             return "PixelWorldWidth";
         case ProgramParameterType::WorldStep:
             return "WorldStep";
+        case ProgramParameterType::PointPositionsTexture:
+            return "PointPositionsTexture";
+        case ProgramParameterType::PointPositionsTextureSize:
+            return "PointPositionsTextureSize";
         default:
             assert(false);
             throw SLabException("Unsupported ProgramParameterType");
@@ -38,7 +38,9 @@ public:
     {
         OrthoMatrix = 0,
         PixelWorldWidth = 1,
-        WorldStep = 2
+        WorldStep = 2,
+        PointPositionsTexture = 3,
+        PointPositionsTextureSize = 4
     };
 
     enum class VertexAttributeType : size_t
@@ -170,6 +172,21 @@ public:
         CheckUniformError<Program, Parameter>();
     }
 
+    template <ProgramType Program, ProgramParameterType Parameter>
+    inline void SetTextureParameter(GLint textureUnitIndex)
+    {
+        constexpr uint32_t programIndex = static_cast<uint32_t>(Program);
+        constexpr uint32_t parameterIndex = static_cast<uint32_t>(Parameter);
+
+        assert(mPrograms[programIndex].UniformLocations[parameterIndex] != NoParameterLocation);
+
+        glUniform1i(
+            mPrograms[programIndex].UniformLocations[parameterIndex],
+            textureUnitIndex);
+
+        CheckUniformError<Program, Parameter>();
+    }
+
     // At any given moment, only one program may be active
     template <ProgramType Program>
     inline void ActivateProgram()
@@ -34,39 +34,94 @@ std::unique_ptr<SimulationController> SimulationController::Create(
     return std::unique_ptr<SimulationController>(
         new SimulationController(
             std::move(renderContext),
-            std::move(structuralMaterialDatabase)));
+            std::move(structuralMaterialDatabase),
+            false));
+}
+
+std::unique_ptr<SimulationController> SimulationController::CreateHeadless()
+{
+    // Load materials
+    StructuralMaterialDatabase structuralMaterialDatabase = StructuralMaterialDatabase::Load();
+
+    //
+    // Create controller
+    //
+
+    return std::unique_ptr<SimulationController>(
+        new SimulationController(
+            nullptr, // No rendering
+            std::move(structuralMaterialDatabase),
+            true)); // No rendering, hence all threads may go to simulation
 }
 
 SimulationController::SimulationController(
     std::unique_ptr<RenderContext> renderContext,
-    StructuralMaterialDatabase structuralMaterialDatabase)
+    StructuralMaterialDatabase structuralMaterialDatabase,
+    bool doForceNoMultithreadedRendering)
     : mEventDispatcher()
     , mRenderContext(std::move(renderContext))
-    , mThreadManager(false, 1) // Initial parallelism=1, we allow user to change later
+    , mThreadManager(doForceNoMultithreadedRendering, 1) // Initial parallelism=1, we allow user to change later
     , mStructuralMaterialDatabase(std::move(structuralMaterialDatabase))
     // Simulation state
     , mSimulator()
     , mCurrentSimulatorTypeName(SimulatorRegistry::GetDefaultSimulatorTypeName())
     , mCurrentSimulationTime(0.0f)
     , mSimulationParameters()
+    , mCurrentSimulationParameters()
     , mObject()
     , mCurrentObjectName()
     , mCurrentObjectDefinitionSource()
     , mIsSimulationStateDirty(false)
+    , mIsCurrentSimulationStateDirty(false)
+    // Simulation thread
+    , mSimulationMutex()
+    , mSimulationLockWaiterCount(0)
+    , mSimulationThread()
+    , mIsSimulationThreadStopRequested(false)
+    , mPointPositionsSnapshots()
+    , mSimulationHandoverMutex()
+    , mHandedOverSimulationParameters()
+    , mHasHandedOverSimulationParameters(false)
+    , mIsObservationRequested(false)
+    , mHandedOverMeasurement()
+    // Interactions
+    , mPointPositionsVersion(1)
+    , mPointSpatialIndex()
+    , mPointSpatialIndexVersion(0)
+    , mPointQueryPositionsVersion(0)
+    , mPointQueryCount(0)
+    , mHasPointQuerySinceIndexRebuild(false)
+    // Observation
+    , mObjectObserver()
+    , mUpdatesSinceLastObservation(0)
     // Parameters
     , mDoRenderAssignedParticleForces(false)
+    , mObservationInterval(1)
     // Stats
     , mPerfStats()
+    , mLastPublishedPerfStats()
 {    
 }
 
+SimulationController::~SimulationController()
+{
+    if (IsSimulationThreadRunning())
+    {
+        StopSimulationThread();
+    }
+}
+
 void SimulationController::SetSimulator(std::string const & simulatorName)
 {
     LogMessage("SimulationController::SetSimulator(", simulatorName, ")");
 
     mCurrentSimulatorTypeName = simulatorName;
 
-    Reset();
+    if (mCurrentObjectDefinitionSource)
+    {
+        // Re-create object, as its layout depends on the simulator
+        Reset();
+    }
 }
 
 void SimulationController::LoadObject(std::filesystem::path const & objectDefinitionFilepath)
@@ -127,42 +182,62 @@ void SimulationController::UpdateSimulation()
     assert(!!mSimulator);
     assert(!!mObject);
 
-    PerfStats const lastPerfStats = mPerfStats;
+    std::optional<Measurement> measurement;
 
-    ////////////////////////////////////////////////////////
-    // Update parameters
-    ////////////////////////////////////////////////////////
+    ++mUpdatesSinceLastObservation;
 
-    if (mIsSimulationStateDirty)
+    if (!IsSimulationThreadRunning())
     {
-        mSimulator->OnStateChanged(*mObject, mSimulationParameters, mThreadManager);
+        auto const lock = LockSimulation();
 
-        mIsSimulationStateDirty = false;
+        SyncSimulationParameters();
+
+        RunSimulationStep();
+
+        if (mUpdatesSinceLastObservation >= mObservationInterval)
+        {
+            measurement.emplace(ObserveObject());
+
+            mUpdatesSinceLastObservation = 0;
+        }
     }
+    else
+    {
+        // The thread might be in the middle of a long step, so we don't take the
+        // simulation lock and rather exchange everything through the handover
 
-    ////////////////////////////////////////////////////////
-    // Update
-    ////////////////////////////////////////////////////////
+        std::lock_guard<std::mutex> const lock(mSimulationHandoverMutex);
 
-    auto const updateStartTimestamp = Chronometer::now();
+        if (mIsSimulationStateDirty)
+        {
+            mHandedOverSimulationParameters = mSimulationParameters;
+            mHasHandedOverSimulationParameters = true;
 
-    // Update simulation
-    mSimulator->Update(
-        *mObject,
-        mCurrentSimulationTime,
-        mSimulationParameters,
-        mThreadManager);
+            mIsSimulationStateDirty = false;
+        }
 
-    mPerfStats.SimulationDuration.Update(std::chrono::duration_cast<std::chrono::nanoseconds>(Chronometer::now() - updateStartTimestamp));
+        if (mUpdatesSinceLastObservation >= mObservationInterval)
+        {
+            // Merges with the previous request, if the thread has not got to it yet
+            mIsObservationRequested = true;
 
-    // Update simulation time    
-    mCurrentSimulationTime += mSimulationParameters.Common.SimulationTimeStepDuration;
+            mUpdatesSinceLastObservation = 0;
+        }
+
+        if (mHandedOverMeasurement)
+        {
+            measurement.swap(mHandedOverMeasurement);
+        }
+    }
 
     ////////////////////////////////////////////////////////
-    // Observe
+    // Publish
     ////////////////////////////////////////////////////////
 
-    ObserveObject(lastPerfStats);
+    if (measurement)
+    {
+        PublishMeasurement(*measurement);
+    }
 }
 
 void SimulationController::Render()
@@ -173,27 +248,22 @@ void SimulationController::Render()
 
     if (mObject)
     {
+        // Latest positions, as published by whoever is stepping the simulation;
+        // other attributes are only changed by this thread
+        std::vector<vec2f> const & pointPositions = mPointPositionsSnapshots.AcquireLatest();
+        assert(pointPositions.size() == mObject->GetPoints().GetElementCount());
+
         mRenderContext->UploadPoints(
             mObject->GetPoints().GetElementCount(),
-            mObject->GetPoints().GetPositionBuffer(),
+            pointPositions.data(),
             mObject->GetPoints().GetRenderColorBuffer(),
             mObject->GetPoints().GetRenderNormRadiusBuffer(),
             mObject->GetPoints().GetRenderHighlightBuffer(),
             mObject->GetPoints().GetFrozenCoefficientBuffer());
 
-        mRenderContext->UploadSpringsStart(mObject->GetSprings().GetElementCount());
-
-        for (auto s : mObject->GetSprings())
-        {
-            mRenderContext->UploadSpring(
-                mObject->GetPoints().GetPosition(mObject->GetSprings().GetEndpointAIndex(s)),
-                mObject->GetPoints().GetPosition(mObject->GetSprings().GetEndpointBIndex(s)),
-                mObject->GetSprings().GetRenderColor(s),
-                mObject->GetSprings().GetRenderNormThickness(s),
-                mObject->GetSprings().GetRenderHighlight(s));
-        }
-
-        mRenderContext->UploadSpringsEnd();
+        mRenderContext->UploadPointPositions(
+            mObject->GetPoints().GetElementCount(),
+            pointPositions.data());
     }
 
     mRenderContext->RenderEnd();
@@ -229,6 +299,47 @@ RgbImageData SimulationController::TakeScreenshot()
     return mRenderContext->TakeScreenshot();
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+// Simulation thread
+/////////////////////////////////////////////////////////////////////////////////
+
+void SimulationController::StartSimulationThread()
+{
+    assert(IsSimulationThreadSupported());
+    assert(!IsSimulationThreadRunning());
+    assert(!!mSimulator);
+
+    LogMessage("SimulationController: starting simulation thread");
+
+    {
+        auto const lock = LockSimulation();
+
+        SyncSimulationParameters();
+    }
+
+    mIsSimulationThreadStopRequested = false;
+    mSimulationThread = std::thread(&SimulationController::RunSimulationThread, this);
+}
+
+void SimulationController::StopSimulationThread()
+{
+    assert(IsSimulationThreadRunning());
+
+    LogMessage("SimulationController: stopping simulation thread");
+
+    mIsSimulationThreadStopRequested = true;
+    mSimulationThread.join();
+
+    // Take changes the thread has not seen, and forget about observations
+    // still in flight
+    {
+        auto const lock = LockSimulation();
+
+        TakeHandedOverSimulationParameters();
+        ClearSimulationHandover();
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 // Simulation parameters
 /////////////////////////////////////////////////////////////////////////////////
@@ -247,6 +358,15 @@ void SimulationController::SetCommonDoApplyGravity(bool value)
     mIsSimulationStateDirty = true;
 }
 
+void SimulationController::SetNumberOfSimulationThreads(size_t value)
+{
+    // The simulator has to adapt to the new thread pool before it steps again
+    auto const lock = LockSimulation();
+
+    mThreadManager.SetSimulationParallelism(value);
+    mIsCurrentSimulationStateDirty = true;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 // Helpers
 /////////////////////////////////////////////////////////////////////////////////
@@ -256,21 +376,55 @@ void SimulationController::Reset(
     std::string objectName,
     ObjectDefinitionSource && currentObjectDefinitionSource)
 {
-    //
-    // Take object in
-    //
+    AABB objectAABB;
+
+    {
+        auto const lock = LockSimulation();
+
+        //
+        // Take object in
+        //
+
+        mObject = std::move(newObject);
+        mCurrentObjectName = objectName;
+        mCurrentObjectDefinitionSource = std::move(currentObjectDefinitionSource);
+
+        //
+        // Reset simulation
+        //
 
-    mObject = std::move(newObject);
-    mCurrentObjectName = objectName;
-    mCurrentObjectDefinitionSource = std::move(currentObjectDefinitionSource);
+        // Take all parameters
+        mCurrentSimulationParameters = mSimulationParameters;
+        mIsSimulationStateDirty = false;
+        mIsCurrentSimulationStateDirty = false;
+
+        // Make new simulator
+        mSimulator = SimulatorRegistry::MakeSimulator(mCurrentSimulatorTypeName, *mObject, mCurrentSimulationParameters, mThreadManager);
+
+        // Reset simulation state
+        mCurrentSimulationTime = 0.0f;
+        ++mPointPositionsVersion;
+        mHasPointQuerySinceIndexRebuild = false;
+        mUpdatesSinceLastObservation = 0;
+        ClearSimulationHandover();
+
+        // Reset stats
+        mPerfStats.Reset();
+        mLastPublishedPerfStats.Reset();
+
+        // Publish initial positions
+        PublishPointPositions();
+
+        // Once we release the lock, positions are not ours to read anymore
+        objectAABB = mObject->GetPoints().GetAABB();
+    }
 
     //
     // Auto-zoom & center
     //
 
+    if (mRenderContext)
     {
-        AABB const objectAABB = mObject->GetPoints().GetAABB();
-
         vec2f const objectSize = objectAABB.GetSize();
 
         // Zoom to fit width and height (plus a nicely-looking margin)
@@ -285,95 +439,197 @@ void SimulationController::Reset(
             (objectAABB.BottomLeft.y + objectAABB.TopRight.y) / 2.0f);
         mRenderContext->SetCameraWorldPosition(objectCenter);
 
+        // Upload static spring attributes
+        mRenderContext->UploadSpringStructure(
+            mObject->GetSprings().GetElementCount(),
+            mObject->GetSprings().GetEndpointsBuffer(),
+            mObject->GetSprings().GetRenderColorBuffer(),
+            mObject->GetSprings().GetRenderNormThicknessBuffer(),
+            mObject->GetSprings().GetRenderHighlightBuffer());
     }
 
     //
-    // Reset simulation
+    // Publish reset
     //
 
-    // Make new simulator
-    mSimulator = SimulatorRegistry::MakeSimulator(mCurrentSimulatorTypeName, *mObject, mSimulationParameters, mThreadManager);
-
-    // Reset simulation state
-    mCurrentSimulationTime = 0.0f;
-    mIsSimulationStateDirty = false;
-
-    // Publish reset
     mEventDispatcher.OnSimulationReset(mObject->GetSprings().GetElementCount());
+}
 
-    //
-    // Reset stats
-    //
+std::unique_lock<std::mutex> SimulationController::LockSimulation() const
+{
+    // Let the simulation thread know that we're waiting, so that it
+    // gives way at the end of its current step
+    ++mSimulationLockWaiterCount;
+    std::unique_lock<std::mutex> lock(mSimulationMutex);
+    --mSimulationLockWaiterCount;
 
-    mPerfStats.Reset();
+    return lock;
 }
 
-void SimulationController::ObserveObject(PerfStats const & lastPerfStats)
+void SimulationController::SyncSimulationParameters()
 {
-    //
-    // Calculate:
-    // - Total kinetic energy
-    // - Total potential energy
-    //
+    if (mIsSimulationStateDirty)
+    {
+        mCurrentSimulationParameters = mSimulationParameters;
+        mIsCurrentSimulationStateDirty = true;
+
+        mIsSimulationStateDirty = false;
+    }
+}
 
-    float totalKineticEnergy = 0;
-    float totalPotentialEnergy = 0;
+void SimulationController::RunSimulationStep()
+{
+    ////////////////////////////////////////////////////////
+    // Update parameters
+    ////////////////////////////////////////////////////////
 
-    auto const & points = mObject->GetPoints();
-    for (auto p : points)
+    if (mIsCurrentSimulationStateDirty)
     {
-        totalKineticEnergy +=
-            points.GetMass(p)
-            * points.GetVelocity(p).squareLength();
+        mSimulator->OnStateChanged(*mObject, mCurrentSimulationParameters, mThreadManager);
+
+        mIsCurrentSimulationStateDirty = false;
     }
 
-    auto const & springs = mObject->GetSprings();
-    for (auto s : springs)
+    ////////////////////////////////////////////////////////
+    // Update
+    ////////////////////////////////////////////////////////
+
+    auto const updateStartTimestamp = Chronometer::now();
+
+    // Update simulation
+    mSimulator->Update(
+        *mObject,
+        mCurrentSimulationTime,
+        mCurrentSimulationParameters,
+        mThreadManager);
+
+    mPerfStats.SimulationDuration.Update(std::chrono::duration_cast<std::chrono::nanoseconds>(Chronometer::now() - updateStartTimestamp));
+
+    // Update simulation time    
+    mCurrentSimulationTime = mCurrentSimulationTime + mCurrentSimulationParameters.Common.SimulationTimeStepDuration;
+
+    ////////////////////////////////////////////////////////
+    // Publish
+    ////////////////////////////////////////////////////////
+
+    PublishPointPositions();
+
+    ++mPointPositionsVersion;
+}
+
+void SimulationController::RunSimulationThread()
+{
+    mThreadManager.InitializeThisThread();
+
+    while (!mIsSimulationThreadStopRequested)
     {
-        auto const endpointAIndex = springs.GetEndpointAIndex(s);
-        auto const endpointBIndex = springs.GetEndpointBIndex(s);
+        // Give way to whoever is waiting for the lock, or else we'd
+        // most likely re-acquire it right away
+        while (mSimulationLockWaiterCount > 0)
+        {
+            std::this_thread::yield();
+        }
 
-        float const displacementLength = (points.GetPosition(endpointBIndex) - points.GetPosition(endpointAIndex)).length();
+        std::lock_guard<std::mutex> const lock(mSimulationMutex);
 
-        // TODOHERE: we can only do this ourselves if MaterialStiffness is all that there is
-        totalPotentialEnergy +=
-            mSimulationParameters.ClassicSimulator.SpringStiffnessCoefficient
-            * springs.GetMaterialStiffness(s)
-            * abs(displacementLength - springs.GetRestLength(s));
-    }
+        TakeHandedOverSimulationParameters();
 
-    totalKineticEnergy *= 0.5f;
-    totalPotentialEnergy *= 0.5f;
+        RunSimulationStep();
 
-    //
-    // Bending
-    //
+        // While points are being queried, keep the spatial index in step with
+        // positions, so that queries don't have to scan all points
+        if (mHasPointQuerySinceIndexRebuild)
+        {
+            RebuildPointSpatialIndex();
+        }
 
-    std::optional<float> bending;
+        if (mIsObservationRequested)
+        {
+            Measurement measurement = ObserveObject();
+
+            std::lock_guard<std::mutex> const handoverLock(mSimulationHandoverMutex);
 
-    auto const & bendingProbe = mObject->GetPoints().GetBendingProbe();
-    if (bendingProbe)
+            mHandedOverMeasurement.emplace(measurement);
+            mIsObservationRequested = false;
+        }
+    }
+}
+
+void SimulationController::TakeHandedOverSimulationParameters()
+{
+    if (mHasHandedOverSimulationParameters)
     {
-        vec2f const & currentProbePosition = mObject->GetPoints().GetPosition(bendingProbe->PointIndex);
+        std::lock_guard<std::mutex> const handoverLock(mSimulationHandoverMutex);
+
+        mCurrentSimulationParameters = mHandedOverSimulationParameters;
+        mIsCurrentSimulationStateDirty = true;
 
-        // TODOHERE: arc?
-        bending = -(currentProbePosition.y - bendingProbe->OriginalWorldCoordinates.y);
+        mHasHandedOverSimulationParameters = false;
     }
+}
+
+void SimulationController::ClearSimulationHandover()
+{
+    std::lock_guard<std::mutex> const handoverLock(mSimulationHandoverMutex);
+
+    mHasHandedOverSimulationParameters = false;
+    mIsObservationRequested = false;
+    mHandedOverMeasurement.reset();
+}
+
+void SimulationController::PublishPointPositions()
+{
+    if (!mRenderContext)
+    {
+        // Nobody to consume them
+        return;
+    }
+
+    auto const & points = mObject->GetPoints();
 
+    std::vector<vec2f> & snapshot = mPointPositionsSnapshots.GetProducerBuffer();
+    snapshot.assign(
+        points.GetPositionBuffer(),
+        points.GetPositionBuffer() + points.GetElementCount());
+
+    mPointPositionsSnapshots.Publish();
+}
+
+void SimulationController::RebuildPointSpatialIndex() const
+{
+    mPointSpatialIndex.Rebuild(mObject->GetPoints());
+    mPointSpatialIndexVersion = mPointPositionsVersion;
+    mHasPointQuerySinceIndexRebuild = false;
+}
+
+SimulationController::Measurement SimulationController::ObserveObject()
+{
+    return Measurement(
+        mObjectObserver.Observe(
+            *mObject,
+            *mSimulator,
+            mCurrentSimulationParameters,
+            mThreadManager),
+        mPerfStats);
+}
+
+void SimulationController::PublishMeasurement(Measurement const & measurement)
+{
     //
     // Update perf
     //
 
-    auto const deltaStats = mPerfStats - lastPerfStats;
+    auto const deltaStats = measurement.Stats - mLastPublishedPerfStats;
+    mLastPublishedPerfStats = measurement.Stats;
 
     //
     // Publish observations
     //
 
     mEventDispatcher.OnMeasurement(
-        totalKineticEnergy,
-        totalPotentialEnergy,
-        bending,
+        measurement.TotalKineticEnergy,
+        measurement.TotalPotentialEnergy,
+        measurement.Bending,
         deltaStats.SimulationDuration.Finalize<std::chrono::nanoseconds>(),
-        mPerfStats.SimulationDuration.Finalize<std::chrono::nanoseconds>());
-}
+        measurement.Stats.SimulationDuration.Finalize<std::chrono::nanoseconds>());
+}
\ No newline at end of file
@@ -9,37 +9,57 @@
 #include "EventDispatcher.h"
 #include "ImageData.h"
 #include "Object.h"
+#include "ObjectObserver.h"
 #include "PerfStats.h"
+#include "PointSpatialIndex.h"
 #include "RenderContext.h"
 #include "SimulationParameters.h"
 #include "SLabTypes.h"
 #include "StructuralMaterialDatabase.h"
 #include "ThreadManager.h"
+#include "TripleBuffer.h"
 #include "Vectors.h"
 
 #include "Simulator/Common/ISimulator.h"
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 /*
  * This class is responsible for managing the simulation - both its lifetime and the user
  * interactions.
+ *
+ * The simulation may be stepped either by the caller's thread, via UpdateSimulation(), or
+ * continuously by a dedicated simulation thread; in the latter case, the object and the
+ * simulator are only touched under the simulation lock, and the renderer consumes the
+ * snapshots of point positions published at the end of each step.
  */
 class SimulationController
 {
 public:
 
+    ~SimulationController();
+
     static std::unique_ptr<SimulationController> Create(
         int initialCanvasWidth,
         int initialCanvasHeight);
 
+    /*
+     * Creates a controller without a render context, for running simulations
+     * without a GUI or an OpenGL context; none of the rendering and render
+     * control methods may be invoked on such a controller.
+     */
+    static std::unique_ptr<SimulationController> CreateHeadless();
+
 public:
 
     void RegisterEventHandler(ISimulationEventHandler * handler)
@@ -57,17 +77,51 @@ public:
 
     void MakeObject(size_t numSprings);
 
+    /*
+     * Steps the simulation once; every ObservationInterval updates, also observes the
+     * object and publishes the resulting measurement.
+     *
+     * When the simulation thread is running, instead, never waits for the step in progress:
+     * hands parameter changes over to the thread, asks it for an observation, and publishes
+     * the measurement of an earlier request if the thread has completed it. An observation
+     * is therefore published one or more updates late, and it is skipped altogether when
+     * it falls due while an earlier one is still pending.
+     */
     void UpdateSimulation();
 
     void Render();
 
     void Reset();
 
+    std::string const & GetCurrentSimulatorTypeName() const
+    {
+        return mCurrentSimulatorTypeName;
+    }
+
     float GetCurrentSimulationTime() const
     {
         return mCurrentSimulationTime;
     }
 
+    //
+    // Simulation thread
+    //
+
+    bool IsSimulationThreadSupported() const
+    {
+        // The thread needs a core of its own, which is the one we'd otherwise give to rendering
+        return !!mRenderContext && mThreadManager.GetIsRenderingMultithreaded();
+    }
+
+    bool IsSimulationThreadRunning() const
+    {
+        return mSimulationThread.joinable();
+    }
+
+    void StartSimulationThread();
+
+    void StopSimulationThread();
+
     //
     // Simulation Interactions
     //
@@ -171,6 +225,9 @@ public:
     bool GetCommonDoApplyGravity() const { return mSimulationParameters.Common.AssignedGravity != vec2f::zero(); }
     void SetCommonDoApplyGravity(bool value);
 
+    bool GetCommonDoFuseEnergyObservation() const { return mSimulationParameters.Common.DoFuseEnergyObservation; }
+    void SetCommonDoFuseEnergyObservation(bool value) { mSimulationParameters.Common.DoFuseEnergyObservation = value; mIsSimulationStateDirty = true; }
+
     float GetClassicSimulatorSpringStiffnessCoefficient() const { return mSimulationParameters.ClassicSimulator.SpringStiffnessCoefficient; }
     void SetClassicSimulatorSpringStiffnessCoefficient(float value) { mSimulationParameters.ClassicSimulator.SpringStiffnessCoefficient = value; mIsSimulationStateDirty = true; }
     float GetClassicSimulatorMinSpringStiffnessCoefficient() const { return ClassicSimulatorParameters::MinSpringStiffnessCoefficient; }
@@ -221,6 +278,11 @@ public:
     float GetPositionBasedSimulatorMinSpringStiffness() const { return PositionBasedCommonSimulatorParameters::MinSpringStiffness; }
     float GetPositionBasedSimulatorMaxSpringStiffness() const { return PositionBasedCommonSimulatorParameters::MaxSpringStiffness; }
 
+    float GetPositionBasedSimulatorXPBDSpringStiffnessCoefficient() const { return mSimulationParameters.PositionBasedCommonSimulator.XPBDSpringStiffnessCoefficient; }
+    void SetPositionBasedSimulatorXPBDSpringStiffnessCoefficient(float value) { mSimulationParameters.PositionBasedCommonSimulator.XPBDSpringStiffnessCoefficient = value; mIsSimulationStateDirty = true; }
+    float GetPositionBasedSimulatorMinXPBDSpringStiffnessCoefficient() const { return PositionBasedCommonSimulatorParameters::MinXPBDSpringStiffnessCoefficient; }
+    float GetPositionBasedSimulatorMaxXPBDSpringStiffnessCoefficient() const { return PositionBasedCommonSimulatorParameters::MaxXPBDSpringStiffnessCoefficient; }
+
     float GetPositionBasedSimulatorGlobalDamping() const { return mSimulationParameters.PositionBasedCommonSimulator.GlobalDamping; }
     void SetPositionBasedSimulatorGlobalDamping(float value) { mSimulationParameters.PositionBasedCommonSimulator.GlobalDamping = value; mIsSimulationStateDirty = true; }
     float GetPositionBasedSimulatorMinGlobalDamping() const { return PositionBasedCommonSimulatorParameters::MinGlobalDamping; }
@@ -241,6 +303,9 @@ public:
     float GetFastMSSSimulatorMinGlobalDamping() const { return FastMSSCommonSimulatorParameters::MinGlobalDamping; }
     float GetFastMSSSimulatorMaxGlobalDamping() const { return FastMSSCommonSimulatorParameters::MaxGlobalDamping; }
 
+    bool GetFastMSSSimulatorDoUseNestedDissectionOrdering() const { return mSimulationParameters.FastMSSCommonSimulator.DoUseNestedDissectionOrdering; }
+    void SetFastMSSSimulatorDoUseNestedDissectionOrdering(bool value) { mSimulationParameters.FastMSSCommonSimulator.DoUseNestedDissectionOrdering = value; mIsSimulationStateDirty = true; }
+
     size_t GetGaussSeidelSimulatorNumMechanicalDynamicsIterations() const { return mSimulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations; }
     void SetGaussSeidelSimulatorNumMechanicalDynamicsIterations(size_t value) { mSimulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations = value; mIsSimulationStateDirty = true; }
     size_t GetGaussSeidelSimulatorMinNumMechanicalDynamicsIterations() const { return GaussSeidelCommonSimulatorParameters::MinNumMechanicalDynamicsIterations; }
@@ -266,7 +331,7 @@ public:
     //
 
     size_t GetNumberOfSimulationThreads() const { return mThreadManager.GetSimulationParallelism(); }
-    void SetNumberOfSimulationThreads(size_t value) { mThreadManager.SetSimulationParallelism(value); mIsSimulationStateDirty = true; }
+    void SetNumberOfSimulationThreads(size_t value);
     size_t GetMinNumberOfSimulationThreads() const { return mThreadManager.GetMinSimulationParallelism(); }
     size_t GetMaxNumberOfSimulationThreads() const { return mThreadManager.GetMaxSimulationParallelism(); }
 
@@ -278,6 +343,11 @@ public:
     bool GetDoRenderAssignedParticleForces() const { return mDoRenderAssignedParticleForces; }
     void SetDoRenderAssignedParticleForces(bool value) { mDoRenderAssignedParticleForces = value; }
 
+    size_t GetObservationInterval() const { return mObservationInterval; }
+    void SetObservationInterval(size_t value) { mObservationInterval = value; }
+    size_t GetMinObservationInterval() const { return 1; }
+    size_t GetMaxObservationInterval() const { return 60; }
+
 private:
 
         struct ObjectDefinitionSource
@@ -306,14 +376,50 @@ private:
 
     SimulationController(
         std::unique_ptr<RenderContext> renderContext,
-        StructuralMaterialDatabase structuralMaterialDatabase);
+        StructuralMaterialDatabase structuralMaterialDatabase,
+        bool doForceNoMultithreadedRendering);
 
     void Reset(
         std::unique_ptr<Object> newObject,
         std::string objectName,
         ObjectDefinitionSource && currentObjectDefinitionSource);
 
-    void ObserveObject(PerfStats const & lastPerfStats);
+    std::unique_lock<std::mutex> LockSimulation() const;
+
+    void SyncSimulationParameters();
+
+    void RunSimulationStep();
+
+    void RunSimulationThread();
+
+    void TakeHandedOverSimulationParameters();
+
+    void ClearSimulationHandover();
+
+    void PublishPointPositions();
+
+    void RebuildPointSpatialIndex() const;
+
+    struct Measurement
+    {
+        float TotalKineticEnergy;
+        float TotalPotentialEnergy;
+        std::optional<float> Bending;
+        PerfStats Stats;
+
+        Measurement(
+            ObjectObserver::Observation const & observation,
+            PerfStats const & stats)
+            : TotalKineticEnergy(observation.TotalKineticEnergy)
+            , TotalPotentialEnergy(observation.TotalPotentialEnergy)
+            , Bending(observation.Bending)
+            , Stats(stats)
+        {}
+    };
+
+    Measurement ObserveObject();
+
+    void PublishMeasurement(Measurement const & measurement);
 
 private:
 
@@ -329,25 +435,72 @@ private:
     std::unique_ptr<ISimulator> mSimulator;
     std::string mCurrentSimulatorTypeName;
 
-    float mCurrentSimulationTime;
+    std::atomic<float> mCurrentSimulationTime;
 
-    SimulationParameters mSimulationParameters;
+    SimulationParameters mSimulationParameters; // As set by the user
+    SimulationParameters mCurrentSimulationParameters; // As seen by the simulator; only touched under the simulation lock
 
     std::unique_ptr<Object> mObject;
     std::string mCurrentObjectName;
     std::optional<ObjectDefinitionSource> mCurrentObjectDefinitionSource;
 
-    bool mIsSimulationStateDirty;
+    bool mIsSimulationStateDirty; // User changes not yet handed over to the simulation
+    bool mIsCurrentSimulationStateDirty; // Changes not yet seen by the simulator; only touched under the simulation lock
+
+    //
+    // Simulation thread
+    //
+
+    mutable std::mutex mSimulationMutex;
+    mutable std::atomic<int> mSimulationLockWaiterCount; // To make the thread give way to interactions
+
+    std::thread mSimulationThread;
+    std::atomic<bool> mIsSimulationThreadStopRequested;
+
+    // Snapshots of point positions, produced under the simulation lock and consumed by rendering
+    TripleBuffer<std::vector<vec2f>> mPointPositionsSnapshots;
+
+    // Parameters and measurements exchanged with the running simulation thread, so that
+    // UpdateSimulation() never has to wait for a step; guarded by the handover mutex, which
+    // is only held for copying
+    std::mutex mSimulationHandoverMutex;
+    SimulationParameters mHandedOverSimulationParameters;
+    std::atomic<bool> mHasHandedOverSimulationParameters;
+    std::atomic<bool> mIsObservationRequested;
+    std::optional<Measurement> mHandedOverMeasurement;
+
+    //
+    // Interactions
+    //
+
+    // Incremented whenever point positions change; all of these are only touched under the simulation lock
+    size_t mPointPositionsVersion;
+
+    mutable PointSpatialIndex mPointSpatialIndex;
+    mutable size_t mPointSpatialIndexVersion; // Positions version the index was built at
+    mutable size_t mPointQueryPositionsVersion; // Positions version of the last query
+    mutable size_t mPointQueryCount; // Number of queries at mPointQueryPositionsVersion
+    mutable bool mHasPointQuerySinceIndexRebuild; // Tells the simulation thread to rebuild the index after its step
+
+    //
+    // Observation
+    //
+
+    ObjectObserver mObjectObserver; // Only touched under the simulation lock
+
+    size_t mUpdatesSinceLastObservation;
 
     //
     // Own parameters
     //
 
     bool mDoRenderAssignedParticleForces;
+    size_t mObservationInterval;
 
     //
     // Stats
     //
 
-    PerfStats mPerfStats;
+    PerfStats mPerfStats; // Only touched under the simulation lock
+    PerfStats mLastPublishedPerfStats;
 };
@@ -9,11 +9,14 @@
 
 // Interaction constants
 float constexpr PointSearchRadius = 0.5f;
+size_t constexpr PointSpatialIndexRebuildQueryCount = 4; // Queries at the same positions before we index them
 
 void SimulationController::SetPointHighlight(ElementIndex pointElementIndex, float highlight)
 {
     assert(!!mObject);
 
+    auto const lock = LockSimulation();
+
     mObject->GetPoints().SetRenderHighlight(pointElementIndex, highlight);
 
     LogMessage("Highlighted point: ", pointElementIndex);
@@ -23,11 +26,42 @@ std::optional<ElementIndex> SimulationController::GetNearestPointAt(vec2f const
 {
     assert(!!mObject);
 
+    vec2f const worldCoordinates = ScreenToWorld(screenCoordinates);
+
+    auto const lock = LockSimulation();
+
     //
-    // Find closest point within the radius
+    // Rebuilding the spatial index costs a few tens of scans, so we don't do it here
+    // at each query. While the simulation thread runs, it rebuilds the index after
+    // each step following a query; otherwise, we rebuild it once positions have held
+    // still for a few queries - as they do while the simulation is paused. Queries
+    // finding the index stale scan all points instead.
     //
 
-    vec2f const worldCoordinates = ScreenToWorld(screenCoordinates);
+    mHasPointQuerySinceIndexRebuild = true;
+
+    if (mPointQueryPositionsVersion != mPointPositionsVersion)
+    {
+        mPointQueryPositionsVersion = mPointPositionsVersion;
+        mPointQueryCount = 0;
+    }
+
+    ++mPointQueryCount;
+
+    if (mPointSpatialIndexVersion != mPointPositionsVersion
+        && mPointQueryCount > PointSpatialIndexRebuildQueryCount)
+    {
+        RebuildPointSpatialIndex();
+    }
+
+    if (mPointSpatialIndexVersion == mPointPositionsVersion)
+    {
+        return mPointSpatialIndex.FindNearestPoint(worldCoordinates, PointSearchRadius);
+    }
+
+    //
+    // Scan for the closest point within the radius
+    //
 
     float constexpr SquareSearchRadius = PointSearchRadius * PointSearchRadius;
 
@@ -56,6 +90,8 @@ vec2f SimulationController::GetPointPosition(ElementIndex pointElementIndex) con
 {
     assert(!!mObject);
 
+    auto const lock = LockSimulation();
+
     return mObject->GetPoints().GetPosition(pointElementIndex);
 }
 
@@ -68,6 +104,8 @@ vec2f SimulationController::GetPointPositionInScreenCoordinates(ElementIndex poi
 
 bool SimulationController::IsPointFrozen(ElementIndex pointElementIndex) const
 {
+    auto const lock = LockSimulation();
+
     return mObject->GetPoints().GetFrozenCoefficient(pointElementIndex) == 0.0f;
 }
 
@@ -77,8 +115,14 @@ void SimulationController::MovePointBy(ElementIndex pointElementIndex, vec2f con
 
     vec2f const worldStride = ScreenOffsetToWorldOffset(screenStride);
 
+    auto const lock = LockSimulation();
+
     mObject->GetPoints().SetPosition(pointElementIndex, mObject->GetPoints().GetPosition(pointElementIndex) + worldStride);
     mObject->GetPoints().SetVelocity(pointElementIndex, vec2f::zero());
+
+    PublishPointPositions();
+
+    ++mPointPositionsVersion;
 }
 
 void SimulationController::MovePointTo(ElementIndex pointElementIndex, vec2f const & screenCoordinates)
@@ -87,14 +131,22 @@ void SimulationController::MovePointTo(ElementIndex pointElementIndex, vec2f con
 
     vec2f const worldCoordinates = ScreenToWorld(screenCoordinates);
 
+    auto const lock = LockSimulation();
+
     mObject->GetPoints().SetPosition(pointElementIndex, worldCoordinates);
     mObject->GetPoints().SetVelocity(pointElementIndex, vec2f::zero());
+
+    PublishPointPositions();
+
+    ++mPointPositionsVersion;
 }
 
 void SimulationController::TogglePointFreeze(ElementIndex pointElementIndex)
 {
     assert(!!mObject);
 
+    auto const lock = LockSimulation();
+
     bool const isNewFrozen = mObject->GetPoints().GetFrozenCoefficient(pointElementIndex) != 0.0f;
 
     if (isNewFrozen)
@@ -107,7 +159,8 @@ void SimulationController::TogglePointFreeze(ElementIndex pointElementIndex)
         mObject->GetPoints().SetFrozenCoefficient(pointElementIndex, 1.0f);
     }
 
-    mIsSimulationStateDirty = true;
+    // The simulator has to see this before it steps again
+    mIsCurrentSimulationStateDirty = true;
 }
 
 void SimulationController::QueryNearestPointAt(vec2f const & screenCoordinates) const
@@ -117,6 +170,8 @@ void SimulationController::QueryNearestPointAt(vec2f const & screenCoordinates)
     auto const nearestPoint = GetNearestPointAt(screenCoordinates);
     if (nearestPoint.has_value())
     {
+        auto const lock = LockSimulation();
+
         mObject->GetPoints().Query(*nearestPoint);
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "ClassicSimulator.h"
 
 #include <cassert>
+#include <cmath>
 
 ClassicSimulator::ClassicSimulator(
     Object const & object,
@@ -18,6 +19,8 @@ ClassicSimulator::ClassicSimulator(
     // Spring buffers
     , mSpringStiffnessCoefficientBuffer(object.GetSprings().GetBufferElementCount(), 0, 0.0f)
     , mSpringDampingCoefficientBuffer(object.GetSprings().GetBufferElementCount(), 0, 0.0f)
+    // Observation
+    , mLastUpdateEnergies()
 {
     CreateState(object, simulationParameters);
 }
@@ -36,12 +39,31 @@ void ClassicSimulator::Update(
     SimulationParameters const & simulationParameters,
     ThreadManager & /*threadManager*/)
 {
-    // Apply spring forces
-    ApplySpringsForces(object);
+    if (!simulationParameters.Common.DoFuseEnergyObservation)
+    {
+        // Apply spring forces
+        ApplySpringsForces<false>(object);
+
+        // Integrate spring and external forces,
+        // and reset spring forces
+        IntegrateAndResetSpringForces<false>(object, simulationParameters);
+
+        mLastUpdateEnergies.reset();
+    }
+    else
+    {
+        // Same as above, accumulating energies along the way; note that
+        // potential energy is thus of the positions at the start of the step,
+        // while kinetic energy is of the velocities at its end
+
+        float const totalPotentialEnergy = ApplySpringsForces<true>(object);
 
-    // Integrate spring and external forces,
-    // and reset spring forces
-    IntegrateAndResetSpringForces(object, simulationParameters);
+        float const totalKineticEnergy = IntegrateAndResetSpringForces<true>(object, simulationParameters);
+
+        mLastUpdateEnergies.emplace(
+            totalKineticEnergy * 0.5f,
+            totalPotentialEnergy * 0.5f);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -96,7 +118,8 @@ void ClassicSimulator::CreateState(
     }
 }
 
-void ClassicSimulator::ApplySpringsForces(Object const & object)
+template<bool DoAccumulateEnergy>
+float ClassicSimulator::ApplySpringsForces(Object const & object)
 {
     vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
     vec2f const * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
@@ -108,6 +131,9 @@ void ClassicSimulator::ApplySpringsForces(Object const & object)
     float const * restrict const dampingCoefficientBuffer = mSpringDampingCoefficientBuffer.data();
 
     ElementCount const springCount = object.GetSprings().GetElementCount();
+
+    float totalPotentialEnergy = 0.0f;
+
     for (ElementIndex springIndex = 0; springIndex < springCount; ++springIndex)
     {
         auto const pointAIndex = endpointsBuffer[springIndex].PointAIndex;
@@ -146,10 +172,18 @@ void ClassicSimulator::ApplySpringsForces(Object const & object)
         vec2f const forceA = springDir * (fSpring + fDamp);
         pointSpringForceBuffer[pointAIndex] += forceA;
         pointSpringForceBuffer[pointBIndex] -= forceA;
+
+        if constexpr (DoAccumulateEnergy)
+        {
+            totalPotentialEnergy += std::abs(displacementLength - restLengthBuffer[springIndex]) * stiffnessCoefficientBuffer[springIndex];
+        }
     }
+
+    return totalPotentialEnergy;
 }
 
-void ClassicSimulator::IntegrateAndResetSpringForces(
+template<bool DoAccumulateEnergy>
+float ClassicSimulator::IntegrateAndResetSpringForces(
     Object & object,
     SimulationParameters const & simulationParameters)
 {
@@ -160,6 +194,7 @@ void ClassicSimulator::IntegrateAndResetSpringForces(
     vec2f * const restrict springForceBuffer = mPointSpringForceBuffer.data();
     vec2f const * const restrict externalForceBuffer = mPointExternalForceBuffer.data();
     float const * const restrict integrationFactorBuffer = mPointIntegrationFactorBuffer.data();
+    float const * const restrict massBuffer = object.GetPoints().GetMassBuffer();
 
     float const globalDampingCoefficient = 1.0f - pow((1.0f - simulationParameters.ClassicSimulator.GlobalDamping), 0.4f);
 
@@ -167,6 +202,8 @@ void ClassicSimulator::IntegrateAndResetSpringForces(
     // provides the final, damped velocity
     float const velocityFactor = globalDampingCoefficient / dt;
 
+    float totalKineticEnergy = 0.0f;
+
     size_t const count = object.GetPoints().GetBufferElementCount();
     for (size_t i = 0; i < count; ++i)
     {
@@ -183,5 +220,12 @@ void ClassicSimulator::IntegrateAndResetSpringForces(
 
         // Zero out spring force now that we've integrated it
         springForceBuffer[i] = vec2f::zero();
+
+        if constexpr (DoAccumulateEnergy)
+        {
+            totalKineticEnergy += massBuffer[i] * velocityBuffer[i].squareLength();
+        }
     }
+
+    return totalKineticEnergy;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "Simulator/Common/ISimulator.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 /*
@@ -45,15 +46,24 @@ public:
         SimulationParameters const & simulationParameters,
         ThreadManager & threadManager) override;
 
+    std::optional<ObjectEnergies> GetLastUpdateEnergies() const override
+    {
+        return mLastUpdateEnergies;
+    }
+
 private:
 
     void CreateState(
         Object const & object,
         SimulationParameters const & simulationParameters);
 
-    void ApplySpringsForces(Object const & object);
+    // Returns the (doubled) total potential energy, if asked to
+    template<bool DoAccumulateEnergy>
+    float ApplySpringsForces(Object const & object);
 
-    void IntegrateAndResetSpringForces(
+    // Returns the (doubled) total kinetic energy, if asked to
+    template<bool DoAccumulateEnergy>
+    float IntegrateAndResetSpringForces(
         Object & object,
         SimulationParameters const & simulationParameters);
 
@@ -74,4 +84,10 @@ private:
 
     Buffer<float> mSpringStiffnessCoefficientBuffer;
     Buffer<float> mSpringDampingCoefficientBuffer;
+
+    //
+    // Observation
+    //
+
+    std::optional<ObjectEnergies> mLastUpdateEnergies;
 };
\ No newline at end of file
@@ -10,5 +10,6 @@ CommonSimulatorParameters::CommonSimulatorParameters()
     , MassAdjustment(1.0f)
     , AssignedGravity(vec2f::zero())
     , GravityAdjustment(1.0f)
+    , DoFuseEnergyObservation(false)
 {
 }
\ No newline at end of file
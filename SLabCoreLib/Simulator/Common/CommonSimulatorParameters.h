@@ -31,4 +31,10 @@ struct CommonSimulatorParameters
     float GravityAdjustment;
     static float constexpr MinGravityAdjustment = 0.0f;
     static float constexpr MaxGravityAdjustment = 1000.0f;
+
+    // Observation
+
+    // When set, simulators that support it accumulate the energies of the
+    // object while updating it, sparing the observer a pass over the object
+    bool DoFuseEnergyObservation;
 };
\ No newline at end of file
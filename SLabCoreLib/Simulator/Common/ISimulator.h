@@ -9,6 +9,21 @@
 #include "SimulationParameters.h"
 #include "ThreadManager.h"
 
+#include <optional>
+
+struct ObjectEnergies
+{
+    float TotalKineticEnergy;
+    float TotalPotentialEnergy;
+
+    ObjectEnergies(
+        float totalKineticEnergy,
+        float totalPotentialEnergy)
+        : TotalKineticEnergy(totalKineticEnergy)
+        , TotalPotentialEnergy(totalPotentialEnergy)
+    {}
+};
+
 class ISimulator
 {
 public:
@@ -34,4 +49,15 @@ public:
         float currentSimulationTime,
         SimulationParameters const & simulationParameters,
         ThreadManager & threadManager) = 0;
+
+    /*
+     * Returns the total energies of the object as accumulated during the last update step,
+     * for simulators that are able to fuse their calculation with their own passes over
+     * the object, and only when asked to do so via the simulation parameters.
+     * When none is returned, the energies are calculated by the observer.
+     */
+    virtual std::optional<ObjectEnergies> GetLastUpdateEnergies() const
+    {
+        return std::nullopt;
+    }
 };
\ No newline at end of file
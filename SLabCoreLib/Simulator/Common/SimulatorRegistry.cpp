@@ -7,6 +7,7 @@
 
 #include "Simulator/Classic/ClassicSimulator.h"
 #include "Simulator/FastMSS/FastMSSBasicSimulator.h"
+#include "Simulator/FastMSS/FastMSSConjugateGradientSimulator.h"
 #include "Simulator/FS/FSBaseSimulator.h"
 #include "Simulator/FS/FSByPointSimulator.h"
 #include "Simulator/FS/FSByPointCompactSimulator.h"
@@ -14,11 +15,24 @@
 #include "Simulator/FS/FSBySpringIntrinsicsSimulator.h"
 #include "Simulator/FS/FSBySpringIntrinsicsLayoutOptimizationSimulator.h"
 #include "Simulator/FS/FSBySpringStructuralIntrinsicsSimulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsAVX2Simulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsCompactEndpointsSimulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsFP16Simulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsFusedSimulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsMTColoredSimulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsMTPersistentSimulator.h"
 #include "Simulator/FS/FSBySpringStructuralIntrinsicsMTSimulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsMTStripedSimulator.h"
 #include "Simulator/FS/FSBySpringStructuralIntrinsicsMTVectorizedSimulator.h"
+#include "Simulator/FS/FSBySpringStructuralIntrinsicsTemporalBlockingSimulator.h"
 #include "Simulator/FS/FSBySpringStructuralPseudoIntrinsicsMTVectorizedSimulator.h"
+#include "Simulator/FS/FSGridSimulator.h"
+#include "Simulator/GaussSeidel/GaussSeidelByPointAVX2Simulator.h"
+#include "Simulator/GaussSeidel/GaussSeidelByPointMTColoredSimulator.h"
 #include "Simulator/GaussSeidel/GaussSeidelByPointSimulator.h"
 #include "Simulator/PositionBased/PositionBasedBasicSimulator.h"
+#include "Simulator/PositionBased/PositionBasedMTColoredSimulator.h"
+#include "Simulator/PositionBased/PositionBasedXPBDSimulator.h"
 
 #include <type_traits>
 
@@ -38,12 +52,26 @@ SimulatorRegistry::SimulatorRegistry()
     RegisterSimulatorType<FSBySpringStructuralIntrinsicsMTSimulator>();
     RegisterSimulatorType<FSBySpringStructuralIntrinsicsMTVectorizedSimulator>();
     RegisterSimulatorType<FSBySpringStructuralPseudoIntrinsicsMTVectorizedSimulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsMTPersistentSimulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsMTColoredSimulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsMTStripedSimulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsAVX2Simulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsFusedSimulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsTemporalBlockingSimulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsFP16Simulator>();
+    RegisterSimulatorType<FSBySpringStructuralIntrinsicsCompactEndpointsSimulator>();
+    RegisterSimulatorType<FSGridSimulator>();
     RegisterSimulatorType<FSByPointSimulator>();
     RegisterSimulatorType<FSByPointCompactSimulator>();
     RegisterSimulatorType<FSByPointCompactIntegratingSimulator>();
     RegisterSimulatorType<GaussSeidelByPointSimulator>();
+    RegisterSimulatorType<GaussSeidelByPointAVX2Simulator>();
+    RegisterSimulatorType<GaussSeidelByPointMTColoredSimulator>();
     RegisterSimulatorType<PositionBasedBasicSimulator>();
+    RegisterSimulatorType<PositionBasedMTColoredSimulator>();
+    RegisterSimulatorType<PositionBasedXPBDSimulator>();
     RegisterSimulatorType<FastMSSBasicSimulator>();
+    RegisterSimulatorType<FastMSSConjugateGradientSimulator>();
 }
 
 /////////////////////////////////////
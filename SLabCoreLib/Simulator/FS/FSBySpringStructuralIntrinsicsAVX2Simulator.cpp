@@ -0,0 +1,298 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsAVX2Simulator.h"
+
+#include "Log.h"
+
+#include <cassert>
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#include <immintrin.h>
+#endif
+
+/*
+ * The AVX2 kernel lays out two perfect squares in the two 128-bit lanes of
+ * YMM registers; since most AVX shuffles work within lanes, each lane goes
+ * through exactly the same steps as the XMM register in the SSE kernel.
+ *
+ * The last odd perfect square, and all leftover springs, are processed
+ * by the SSE kernel.
+ */
+
+FSBySpringStructuralIntrinsicsAVX2Simulator::FSBySpringStructuralIntrinsicsAVX2Simulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mIsAVX2Supported(is_avx2_fma_supported())
+{
+    LogMessage("FSBySpringStructuralIntrinsicsAVX2Simulator: isAVX2Supported=", mIsAVX2Supported ? "YES" : "NO");
+}
+
+void FSBySpringStructuralIntrinsicsAVX2Simulator::ApplySpringsForces(
+    Object const & object,
+    ThreadManager & /*threadManager*/)
+{
+    if (mIsAVX2Supported)
+    {
+        ApplySpringsForcesAVX2(
+            object,
+            mPointSpringForceBuffer.data(),
+            0,
+            mSpringPerfectSquareCount * 4,
+            object.GetSprings().GetElementCount());
+    }
+    else
+    {
+        ApplySpringsForcesVectorized(
+            object,
+            mPointSpringForceBuffer.data(),
+            0,
+            object.GetSprings().GetElementCount());
+    }
+}
+
+FS_TARGET_AVX2_FMA void FSBySpringStructuralIntrinsicsAVX2Simulator::ApplySpringsForcesAVX2(
+    Object const & object,
+    vec2f * restrict pointSpringForceBuffer,
+    ElementIndex startSpringIndex,
+    ElementCount endSpringIndexPerfectSquare, // Excluded
+    ElementCount endSpringIndex)  // Excluded
+{
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+
+    vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f const * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+
+    Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+    float const * restrict const stiffnessCoefficientBuffer = mSpringStiffnessCoefficientBuffer.data();
+    float const * restrict const dampingCoefficientBuffer = mSpringDampingCoefficientBuffer.data();
+
+    __m256 const Zero = _mm256_setzero_ps();
+    alignas(32) vec2f tmpSpringForces[8];
+
+    assert(endSpringIndexPerfectSquare <= endSpringIndex);
+    assert(((endSpringIndexPerfectSquare - startSpringIndex) % 4) == 0);
+
+    ElementIndex s = startSpringIndex;
+
+    //
+    // 1. Perfect squares, two by two
+    //
+
+    ElementCount const endSpringIndexPerfectSquarePairs = s + (endSpringIndexPerfectSquare - s) / 8 * 8;
+
+    for (; s < endSpringIndexPerfectSquarePairs; s += 8)
+    {
+        // YMM register notation:
+        //   low lane: first perfect square (s0..s3), high lane: second perfect square (s4..s7)
+        //
+        // Each perfect square, as in the SSE kernel:
+        //
+        //    J          M   ---  a
+        //    |\        /|
+        //    | \s0  s1/ |
+        //    |  \    /  |
+        //  s2|   \  /   |s3
+        //    |    \/    |
+        //    |    /\    |
+        //    |   /  \   |
+        //    |  /    \  |
+        //    | /      \ |
+        //    |/        \|
+        //    K          L  ---  b
+        //
+
+        ElementIndex const point1JIndex = endpointsBuffer[s + 0].PointAIndex;
+        ElementIndex const point1KIndex = endpointsBuffer[s + 1].PointBIndex;
+        ElementIndex const point1LIndex = endpointsBuffer[s + 0].PointBIndex;
+        ElementIndex const point1MIndex = endpointsBuffer[s + 1].PointAIndex;
+
+        ElementIndex const point2JIndex = endpointsBuffer[s + 4].PointAIndex;
+        ElementIndex const point2KIndex = endpointsBuffer[s + 5].PointBIndex;
+        ElementIndex const point2LIndex = endpointsBuffer[s + 4].PointBIndex;
+        ElementIndex const point2MIndex = endpointsBuffer[s + 5].PointAIndex;
+
+        //
+        // Calculate displacements, string lengths, and spring directions
+        //
+
+        // j_pos_x, j_pos_y, m_pos_x, m_pos_y (per lane)
+        __m256 const jm_pos_xy = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(
+                _mm_loadh_pi(
+                    _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + point1JIndex))),
+                    reinterpret_cast<__m64 const *>(pointPositionBuffer + point1MIndex))),
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + point2JIndex))),
+                reinterpret_cast<__m64 const *>(pointPositionBuffer + point2MIndex)),
+            1);
+
+        // l_pos_x, l_pos_y, k_pos_x, k_pos_y (per lane)
+        __m256 lk_pos_xy = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(
+                _mm_loadh_pi(
+                    _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + point1LIndex))),
+                    reinterpret_cast<__m64 const *>(pointPositionBuffer + point1KIndex))),
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + point2LIndex))),
+                reinterpret_cast<__m64 const *>(pointPositionBuffer + point2KIndex)),
+            1);
+
+        __m256 const s0s1_dis_xy = _mm256_sub_ps(lk_pos_xy, jm_pos_xy);
+        lk_pos_xy = _mm256_shuffle_ps(lk_pos_xy, lk_pos_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256 const s2s3_dis_xy = _mm256_sub_ps(lk_pos_xy, jm_pos_xy);
+
+        __m256 const s0_7_dis_x = _mm256_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0x88);
+        __m256 const s0_7_dis_y = _mm256_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0xDD);
+
+        // Calculate spring lengths: sqrt( x*x + y*y ), via reciprocal square root as in the SSE kernel
+
+        __m256 const sq_len =
+            _mm256_fmadd_ps(
+                s0_7_dis_x,
+                s0_7_dis_x,
+                _mm256_mul_ps(s0_7_dis_y, s0_7_dis_y));
+
+        __m256 const validMask = _mm256_cmp_ps(sq_len, Zero, _CMP_NEQ_OQ); // SL==0 => 1/SL==0, to maintain "normalized == (0, 0)", as in vec2f
+
+        __m256 const s0_7_springLength_inv =
+            _mm256_and_ps(
+                _mm256_rsqrt_ps(sq_len),
+                validMask);
+
+        __m256 const s0_7_springLength =
+            _mm256_and_ps(
+                _mm256_rcp_ps(s0_7_springLength_inv),
+                validMask);
+
+        // Calculate spring directions
+        __m256 const s0_7_sdir_x = _mm256_mul_ps(s0_7_dis_x, s0_7_springLength_inv);
+        __m256 const s0_7_sdir_y = _mm256_mul_ps(s0_7_dis_y, s0_7_springLength_inv);
+
+        //////////////////////////////////////////////////////////////////////////////////////////////
+
+        //
+        // 1. Hooke's law
+        //
+        //    (displacementLength[s] - restLength[s]) * stiffness[s]
+        //
+
+        __m256 const s0_7_hooke_forceModuli =
+            _mm256_mul_ps(
+                _mm256_sub_ps(
+                    s0_7_springLength,
+                    _mm256_loadu_ps(restLengthBuffer + s)),
+                _mm256_loadu_ps(stiffnessCoefficientBuffer + s));
+
+        //
+        // 2. Damper forces
+        //
+        //      relVelocity.dot(springDir) * dampingCoeff[s]
+        //
+
+        __m256 const jm_vel_xy = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(
+                _mm_loadh_pi(
+                    _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + point1JIndex))),
+                    reinterpret_cast<__m64 const *>(pointVelocityBuffer + point1MIndex))),
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + point2JIndex))),
+                reinterpret_cast<__m64 const *>(pointVelocityBuffer + point2MIndex)),
+            1);
+
+        __m256 lk_vel_xy = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(
+                _mm_loadh_pi(
+                    _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + point1LIndex))),
+                    reinterpret_cast<__m64 const *>(pointVelocityBuffer + point1KIndex))),
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + point2LIndex))),
+                reinterpret_cast<__m64 const *>(pointVelocityBuffer + point2KIndex)),
+            1);
+
+        __m256 const s0s1_rvel_xy = _mm256_sub_ps(lk_vel_xy, jm_vel_xy);
+        lk_vel_xy = _mm256_shuffle_ps(lk_vel_xy, lk_vel_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256 const s2s3_rvel_xy = _mm256_sub_ps(lk_vel_xy, jm_vel_xy);
+
+        __m256 const s0_7_rvel_x = _mm256_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0x88);
+        __m256 const s0_7_rvel_y = _mm256_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0xDD);
+
+        __m256 const s0_7_rvel_dot_sdir =
+            _mm256_fmadd_ps(
+                s0_7_rvel_x,
+                s0_7_sdir_x,
+                _mm256_mul_ps(s0_7_rvel_y, s0_7_sdir_y));
+
+        //
+        // 3. Apply forces:
+        //      force A = springDir * (hookeForce + dampingForce)
+        //      force B = - forceA
+        //
+
+        __m256 const tForceModuli =
+            _mm256_fmadd_ps(
+                s0_7_rvel_dot_sdir,
+                _mm256_loadu_ps(dampingCoefficientBuffer + s),
+                s0_7_hooke_forceModuli);
+
+        __m256 const s0_7_tforceA_x = _mm256_mul_ps(s0_7_sdir_x, tForceModuli);
+        __m256 const s0_7_tforceA_y = _mm256_mul_ps(s0_7_sdir_y, tForceModuli);
+
+        //
+        // Unpack and add forces, per lane:
+        //
+        // j_sforce += s0_a_tforce + s2_a_tforce
+        // m_sforce += s1_a_tforce + s3_a_tforce
+        //
+        // l_sforce -= s0_a_tforce + s3_a_tforce
+        // k_sforce -= s1_a_tforce + s2_a_tforce
+        //
+
+        __m256 s0s1_tforceA_xy = _mm256_unpacklo_ps(s0_7_tforceA_x, s0_7_tforceA_y);
+        __m256 s2s3_tforceA_xy = _mm256_unpackhi_ps(s0_7_tforceA_x, s0_7_tforceA_y);
+
+        __m256 const jm_sforce_xy = _mm256_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+        s2s3_tforceA_xy = _mm256_shuffle_ps(s2s3_tforceA_xy, s2s3_tforceA_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256 const lk_sforce_xy = _mm256_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+
+        // j1, m1, j2, m2
+        _mm256_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), jm_sforce_xy);
+        // l1, k1, l2, k2
+        _mm256_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[4])), lk_sforce_xy);
+
+        // Perfect squares may share points, hence we add one square after the other
+        pointSpringForceBuffer[point1JIndex] += tmpSpringForces[0];
+        pointSpringForceBuffer[point1MIndex] += tmpSpringForces[1];
+        pointSpringForceBuffer[point1LIndex] -= tmpSpringForces[4];
+        pointSpringForceBuffer[point1KIndex] -= tmpSpringForces[5];
+
+        pointSpringForceBuffer[point2JIndex] += tmpSpringForces[2];
+        pointSpringForceBuffer[point2MIndex] += tmpSpringForces[3];
+        pointSpringForceBuffer[point2LIndex] -= tmpSpringForces[6];
+        pointSpringForceBuffer[point2KIndex] -= tmpSpringForces[7];
+    }
+
+    // Avoid AVX-SSE transition penalties
+    _mm256_zeroupper();
+
+    //
+    // 2. Odd perfect square and leftovers: SSE
+    //
+
+    ApplySpringsForcesVectorized(
+        object,
+        pointSpringForceBuffer,
+        s,
+        endSpringIndexPerfectSquare,
+        endSpringIndex);
+}
@@ -0,0 +1,60 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+
+#include "Simulator/Common/ISimulator.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <memory>
+#include <string>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * with perfect squares processed two at a time with AVX2 and FMA.
+ *
+ * Falls back to the SSE implementation when the CPU does not
+ * support AVX2 and FMA.
+ */
+
+class FSBySpringStructuralIntrinsicsAVX2Simulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 19 - By Spring - Structural Instrinsics - AVX2";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsAVX2Simulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+private:
+
+    void ApplySpringsForces(
+        Object const & object,
+        ThreadManager & threadManager) override;
+
+    FS_TARGET_AVX2_FMA void ApplySpringsForcesAVX2(
+        Object const & object,
+        vec2f * restrict pointSpringForceBuffer,
+        ElementIndex startSpringIndex,
+        ElementCount endSpringIndexPerfectSquare, // Excluded
+        ElementCount endSpringIndex);  // Excluded
+
+private:
+
+    bool const mIsAVX2Supported;
+};
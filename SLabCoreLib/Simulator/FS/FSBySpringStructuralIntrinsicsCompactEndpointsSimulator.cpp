@@ -0,0 +1,257 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsCompactEndpointsSimulator.h"
+
+#include "Log.h"
+
+#include <cassert>
+#include <limits>
+
+/*
+ * A perfect square's four springs have four endpoints altogether (see the SSE kernel):
+ *
+ *  J = s0.A = s2.A
+ *  K = s1.B = s2.B
+ *  L = s0.B = s3.B
+ *  M = s1.A = s3.A
+ *
+ * The "Structural Intrinsics" layout optimizer lays out the points of a square close
+ * to each other, hence we only store J's index and the offsets of K, L, and M from J:
+ * twelve bytes per square, rather than the 32 bytes of the springs' endpoints.
+ *
+ * Leftover springs are few, and keep using their regular endpoints.
+ */
+
+FSBySpringStructuralIntrinsicsCompactEndpointsSimulator::FSBySpringStructuralIntrinsicsCompactEndpointsSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mPerfectSquareEndpointsBuffer(mSpringPerfectSquareCount)
+    , mIsCompactEndpointsValid(false)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsCompactEndpointsSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsSimulator::CreateState(object, simulationParameters, threadManager);
+
+    Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
+
+    auto const makeOffset = [](ElementIndex pointIndex, ElementIndex basePointIndex, bool & isValid) -> std::int16_t
+    {
+        std::int64_t const offset = static_cast<std::int64_t>(pointIndex) - static_cast<std::int64_t>(basePointIndex);
+        if (offset < std::numeric_limits<std::int16_t>::min() || offset > std::numeric_limits<std::int16_t>::max())
+        {
+            isValid = false;
+            return 0;
+        }
+
+        return static_cast<std::int16_t>(offset);
+    };
+
+    mIsCompactEndpointsValid = true;
+
+    for (ElementIndex sq = 0; sq < mSpringPerfectSquareCount; ++sq)
+    {
+        ElementIndex const s = sq * 4;
+
+        ElementIndex const pointJIndex = endpointsBuffer[s + 0].PointAIndex;
+
+        mPerfectSquareEndpointsBuffer[sq] = PerfectSquareEndpoints(
+            pointJIndex,
+            makeOffset(endpointsBuffer[s + 1].PointBIndex, pointJIndex, mIsCompactEndpointsValid),
+            makeOffset(endpointsBuffer[s + 0].PointBIndex, pointJIndex, mIsCompactEndpointsValid),
+            makeOffset(endpointsBuffer[s + 1].PointAIndex, pointJIndex, mIsCompactEndpointsValid));
+    }
+
+    LogMessage("FSBySpringStructuralIntrinsicsCompactEndpointsSimulator: isCompactEndpointsValid=", mIsCompactEndpointsValid ? "YES" : "NO");
+}
+
+void FSBySpringStructuralIntrinsicsCompactEndpointsSimulator::ApplySpringsForces(
+    Object const & object,
+    ThreadManager & /*threadManager*/)
+{
+    ElementCount const springCount = static_cast<ElementCount>(object.GetSprings().GetElementCount());
+
+    if (mIsCompactEndpointsValid)
+    {
+        // Perfect squares
+        ApplySpringsForcesCompact(
+            object,
+            mPointSpringForceBuffer.data(),
+            0,
+            mSpringPerfectSquareCount * 4);
+
+        // Leftovers
+        ApplySpringsForcesVectorized(
+            object,
+            mPointSpringForceBuffer.data(),
+            mSpringPerfectSquareCount * 4,
+            mSpringPerfectSquareCount * 4,
+            springCount);
+    }
+    else
+    {
+        ApplySpringsForcesVectorized(
+            object,
+            mPointSpringForceBuffer.data(),
+            0,
+            springCount);
+    }
+}
+
+void FSBySpringStructuralIntrinsicsCompactEndpointsSimulator::ApplySpringsForcesCompact(
+    Object const & object,
+    vec2f * restrict pointSpringForceBuffer,
+    ElementIndex startSpringIndex,
+    ElementCount endSpringIndexPerfectSquare) // Excluded
+{
+    // This implementation is for 4-float SSE
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f const * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+
+    PerfectSquareEndpoints const * restrict const perfectSquareEndpointsBuffer = mPerfectSquareEndpointsBuffer.data();
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+    float const * restrict const stiffnessCoefficientBuffer = mSpringStiffnessCoefficientBuffer.data();
+    float const * restrict const dampingCoefficientBuffer = mSpringDampingCoefficientBuffer.data();
+
+    __m128 const Zero = _mm_setzero_ps();
+    aligned_to_vword vec2f tmpSpringForces[4];
+
+    assert(((endSpringIndexPerfectSquare - startSpringIndex) % 4) == 0);
+
+    for (ElementIndex s = startSpringIndex; s < endSpringIndexPerfectSquare; s += 4)
+    {
+        //
+        // See the SSE kernel for the notation and the strategy; the only difference
+        // is in the decoding of the endpoints
+        //
+
+        PerfectSquareEndpoints const & endpoints = perfectSquareEndpointsBuffer[s / 4];
+
+        ElementIndex const pointJIndex = endpoints.PointJIndex;
+        ElementIndex const pointKIndex = static_cast<ElementIndex>(static_cast<std::int32_t>(pointJIndex) + endpoints.PointKOffset);
+        ElementIndex const pointLIndex = static_cast<ElementIndex>(static_cast<std::int32_t>(pointJIndex) + endpoints.PointLOffset);
+        ElementIndex const pointMIndex = static_cast<ElementIndex>(static_cast<std::int32_t>(pointJIndex) + endpoints.PointMOffset);
+
+        assert(pointJIndex == object.GetSprings().GetEndpointsBuffer()[s + 0].PointAIndex);
+        assert(pointKIndex == object.GetSprings().GetEndpointsBuffer()[s + 1].PointBIndex);
+        assert(pointLIndex == object.GetSprings().GetEndpointsBuffer()[s + 0].PointBIndex);
+        assert(pointMIndex == object.GetSprings().GetEndpointsBuffer()[s + 1].PointAIndex);
+
+        //
+        // Calculate displacements, string lengths, and spring directions
+        //
+
+        __m128 const j_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointJIndex)));
+        __m128 const k_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointKIndex)));
+        __m128 const l_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointLIndex)));
+        __m128 const m_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointMIndex)));
+
+        __m128 const jm_pos_xy = _mm_movelh_ps(j_pos_xy, m_pos_xy); // First argument goes low
+        __m128 lk_pos_xy = _mm_movelh_ps(l_pos_xy, k_pos_xy); // First argument goes low
+        __m128 const s0s1_dis_xy = _mm_sub_ps(lk_pos_xy, jm_pos_xy);
+        lk_pos_xy = _mm_shuffle_ps(lk_pos_xy, lk_pos_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 const s2s3_dis_xy = _mm_sub_ps(lk_pos_xy, jm_pos_xy);
+
+        __m128 const s0s1s2s3_dis_x = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0x88);
+        __m128 const s0s1s2s3_dis_y = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0xDD);
+
+        __m128 const sq_len =
+            _mm_add_ps(
+                _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_dis_x),
+                _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_dis_y));
+
+        __m128 const validMask = _mm_cmpneq_ps(sq_len, Zero); // SL==0 => 1/SL==0, to maintain "normalized == (0, 0)", as in vec2f
+
+        __m128 const s0s1s2s3_springLength_inv =
+            _mm_and_ps(
+                _mm_rsqrt_ps(sq_len),
+                validMask);
+
+        __m128 const s0s1s2s3_springLength =
+            _mm_and_ps(
+                _mm_rcp_ps(s0s1s2s3_springLength_inv),
+                validMask);
+
+        __m128 const s0s1s2s3_sdir_x = _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_springLength_inv);
+        __m128 const s0s1s2s3_sdir_y = _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_springLength_inv);
+
+        //
+        // 1. Hooke's law
+        //
+
+        __m128 const s0s1s2s3_hooke_forceModuli =
+            _mm_mul_ps(
+                _mm_sub_ps(
+                    s0s1s2s3_springLength,
+                    _mm_loadu_ps(restLengthBuffer + s)),
+                _mm_loadu_ps(stiffnessCoefficientBuffer + s));
+
+        //
+        // 2. Damper forces
+        //
+
+        __m128 const j_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointJIndex)));
+        __m128 const k_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointKIndex)));
+        __m128 const l_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointLIndex)));
+        __m128 const m_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointMIndex)));
+
+        __m128 const jm_vel_xy = _mm_movelh_ps(j_vel_xy, m_vel_xy); // First argument goes low
+        __m128 lk_vel_xy = _mm_movelh_ps(l_vel_xy, k_vel_xy); // First argument goes low
+        __m128 const s0s1_rvel_xy = _mm_sub_ps(lk_vel_xy, jm_vel_xy);
+        lk_vel_xy = _mm_shuffle_ps(lk_vel_xy, lk_vel_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 const s2s3_rvel_xy = _mm_sub_ps(lk_vel_xy, jm_vel_xy);
+
+        __m128 const s0s1s2s3_rvel_x = _mm_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0x88);
+        __m128 const s0s1s2s3_rvel_y = _mm_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0xDD);
+
+        __m128 const s0s1s2s3_damping_forceModuli =
+            _mm_mul_ps(
+                _mm_add_ps( // Dot product
+                    _mm_mul_ps(s0s1s2s3_rvel_x, s0s1s2s3_sdir_x),
+                    _mm_mul_ps(s0s1s2s3_rvel_y, s0s1s2s3_sdir_y)),
+                _mm_loadu_ps(dampingCoefficientBuffer + s));
+
+        //
+        // 3. Apply forces
+        //
+
+        __m128 const tForceModuli = _mm_add_ps(s0s1s2s3_hooke_forceModuli, s0s1s2s3_damping_forceModuli);
+
+        __m128 const s0s1s2s3_tforceA_x = _mm_mul_ps(s0s1s2s3_sdir_x, tForceModuli);
+        __m128 const s0s1s2s3_tforceA_y = _mm_mul_ps(s0s1s2s3_sdir_y, tForceModuli);
+
+        __m128 s0s1_tforceA_xy = _mm_unpacklo_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[0], b[0], a[1], b[1]
+        __m128 s2s3_tforceA_xy = _mm_unpackhi_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[2], b[2], a[3], b[3]
+
+        __m128 const jm_sforce_xy = _mm_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+        s2s3_tforceA_xy = _mm_shuffle_ps(s2s3_tforceA_xy, s2s3_tforceA_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 const lk_sforce_xy = _mm_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), jm_sforce_xy);
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[2])), lk_sforce_xy);
+
+        pointSpringForceBuffer[pointJIndex] += tmpSpringForces[0];
+        pointSpringForceBuffer[pointMIndex] += tmpSpringForces[1];
+        pointSpringForceBuffer[pointLIndex] -= tmpSpringForces[2];
+        pointSpringForceBuffer[pointKIndex] -= tmpSpringForces[3];
+    }
+}
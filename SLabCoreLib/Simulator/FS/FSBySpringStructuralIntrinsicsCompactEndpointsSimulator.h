@@ -0,0 +1,91 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+
+#include "Buffer.h"
+#include "Simulator/Common/ISimulator.h"
+#include "Vectors.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * with the endpoints of each perfect square stored compactly as
+ * the index of one point and the 16-bit offsets of the other three.
+ */
+
+class FSBySpringStructuralIntrinsicsCompactEndpointsSimulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 33 - By Spring - Structural Instrinsics - Compact Endpoints";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsCompactEndpointsSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+private:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void ApplySpringsForces(
+        Object const & object,
+        ThreadManager & threadManager) override;
+
+    void ApplySpringsForcesCompact(
+        Object const & object,
+        vec2f * restrict pointSpringForceBuffer,
+        ElementIndex startSpringIndex,
+        ElementCount endSpringIndexPerfectSquare); // Excluded
+
+private:
+
+    // The four endpoints of a perfect square, i.e. of its four springs
+    struct PerfectSquareEndpoints
+    {
+        ElementIndex PointJIndex;
+        std::int16_t PointKOffset;
+        std::int16_t PointLOffset;
+        std::int16_t PointMOffset;
+        std::int16_t Padding;
+
+        PerfectSquareEndpoints(
+            ElementIndex pointJIndex,
+            std::int16_t pointKOffset,
+            std::int16_t pointLOffset,
+            std::int16_t pointMOffset)
+            : PointJIndex(pointJIndex)
+            , PointKOffset(pointKOffset)
+            , PointLOffset(pointLOffset)
+            , PointMOffset(pointMOffset)
+            , Padding(0)
+        {}
+    };
+
+    static_assert(sizeof(PerfectSquareEndpoints) == 12);
+
+    Buffer<PerfectSquareEndpoints> mPerfectSquareEndpointsBuffer;
+
+    // False when some perfect square's offsets do not fit 16 bits, in which
+    // case we use the regular endpoints
+    bool mIsCompactEndpointsValid;
+};
@@ -0,0 +1,281 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsFP16Simulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#include <immintrin.h>
+#endif
+
+/*
+ * Only perfect squares - the vast majority of springs in a structural object - use
+ * halves; the few leftover springs are processed by the full-precision SSE kernel.
+ *
+ * Halves have 11 bits of mantissa, and a max value of 65504; stiffness and damping
+ * coefficients are thus stored divided by a power of two, chosen so that the largest
+ * coefficient is around 2^14. Rest lengths are stored as they are.
+ */
+
+namespace /* anonymous */ {
+
+    float CalculateHalfScale(
+        float const * restrict values,
+        ElementCount count)
+    {
+        float maxValue = 0.0f;
+        for (ElementIndex i = 0; i < count; ++i)
+        {
+            maxValue = std::max(maxValue, std::abs(values[i]));
+        }
+
+        if (maxValue == 0.0f)
+        {
+            return 1.0f;
+        }
+
+        return std::ldexp(1.0f, static_cast<int>(std::ceil(std::log2(maxValue))) - 14);
+    }
+}
+
+FSBySpringStructuralIntrinsicsFP16Simulator::FSBySpringStructuralIntrinsicsFP16Simulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mIsF16CSupported(is_f16c_supported())
+    , mSpringRestLengthHalfBuffer(mSpringPerfectSquareCount * 4)
+    , mSpringStiffnessCoefficientHalfBuffer(mSpringPerfectSquareCount * 4)
+    , mSpringDampingCoefficientHalfBuffer(mSpringPerfectSquareCount * 4)
+    , mSpringStiffnessCoefficientScale(1.0f)
+    , mSpringDampingCoefficientScale(1.0f)
+{
+    LogMessage("FSBySpringStructuralIntrinsicsFP16Simulator: isF16CSupported=", mIsF16CSupported ? "YES" : "NO");
+
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsFP16Simulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsSimulator::CreateState(object, simulationParameters, threadManager);
+
+    if (mIsF16CSupported)
+    {
+        CreateHalfState(object);
+    }
+}
+
+FS_TARGET_F16C void FSBySpringStructuralIntrinsicsFP16Simulator::CreateHalfState(Object const & object)
+{
+    ElementCount const perfectSquareSpringCount = mSpringPerfectSquareCount * 4;
+
+    mSpringStiffnessCoefficientScale = CalculateHalfScale(mSpringStiffnessCoefficientBuffer.data(), perfectSquareSpringCount);
+    mSpringDampingCoefficientScale = CalculateHalfScale(mSpringDampingCoefficientBuffer.data(), perfectSquareSpringCount);
+
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+
+    for (ElementIndex s = 0; s < perfectSquareSpringCount; ++s)
+    {
+        mSpringRestLengthHalfBuffer[s] = _cvtss_sh(restLengthBuffer[s], _MM_FROUND_TO_NEAREST_INT);
+        mSpringStiffnessCoefficientHalfBuffer[s] = _cvtss_sh(mSpringStiffnessCoefficientBuffer[s] / mSpringStiffnessCoefficientScale, _MM_FROUND_TO_NEAREST_INT);
+        mSpringDampingCoefficientHalfBuffer[s] = _cvtss_sh(mSpringDampingCoefficientBuffer[s] / mSpringDampingCoefficientScale, _MM_FROUND_TO_NEAREST_INT);
+    }
+
+    LogMessage("FSBySpringStructuralIntrinsicsFP16Simulator: stiffnessScale=", mSpringStiffnessCoefficientScale, " dampingScale=", mSpringDampingCoefficientScale);
+}
+
+void FSBySpringStructuralIntrinsicsFP16Simulator::ApplySpringsForces(
+    Object const & object,
+    ThreadManager & /*threadManager*/)
+{
+    ElementCount const springCount = static_cast<ElementCount>(object.GetSprings().GetElementCount());
+
+    if (mIsF16CSupported)
+    {
+        // Perfect squares
+        ApplySpringsForcesFP16(
+            object,
+            mPointSpringForceBuffer.data(),
+            0,
+            mSpringPerfectSquareCount * 4);
+
+        // Leftovers
+        ApplySpringsForcesVectorized(
+            object,
+            mPointSpringForceBuffer.data(),
+            mSpringPerfectSquareCount * 4,
+            mSpringPerfectSquareCount * 4,
+            springCount);
+    }
+    else
+    {
+        ApplySpringsForcesVectorized(
+            object,
+            mPointSpringForceBuffer.data(),
+            0,
+            springCount);
+    }
+}
+
+FS_TARGET_F16C void FSBySpringStructuralIntrinsicsFP16Simulator::ApplySpringsForcesFP16(
+    Object const & object,
+    vec2f * restrict pointSpringForceBuffer,
+    ElementIndex startSpringIndex,
+    ElementCount endSpringIndexPerfectSquare) // Excluded
+{
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+
+    vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f const * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+
+    Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
+    std::uint16_t const * restrict const restLengthBuffer = mSpringRestLengthHalfBuffer.data();
+    std::uint16_t const * restrict const stiffnessCoefficientBuffer = mSpringStiffnessCoefficientHalfBuffer.data();
+    std::uint16_t const * restrict const dampingCoefficientBuffer = mSpringDampingCoefficientHalfBuffer.data();
+
+    __m128 const Zero = _mm_setzero_ps();
+    __m128 const StiffnessCoefficientScale = _mm_set1_ps(mSpringStiffnessCoefficientScale);
+    __m128 const DampingCoefficientScale = _mm_set1_ps(mSpringDampingCoefficientScale);
+    aligned_to_vword vec2f tmpSpringForces[4];
+
+    assert(((endSpringIndexPerfectSquare - startSpringIndex) % 4) == 0);
+
+    for (ElementIndex s = startSpringIndex; s < endSpringIndexPerfectSquare; s += 4)
+    {
+        //
+        // See the SSE kernel for the notation and the strategy; the only difference
+        // is in the loading of the spring constants
+        //
+
+        ElementIndex const pointJIndex = endpointsBuffer[s + 0].PointAIndex;
+        ElementIndex const pointKIndex = endpointsBuffer[s + 1].PointBIndex;
+        ElementIndex const pointLIndex = endpointsBuffer[s + 0].PointBIndex;
+        ElementIndex const pointMIndex = endpointsBuffer[s + 1].PointAIndex;
+
+        //
+        // Calculate displacements, string lengths, and spring directions
+        //
+
+        __m128 const j_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointJIndex)));
+        __m128 const k_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointKIndex)));
+        __m128 const l_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointLIndex)));
+        __m128 const m_pos_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionBuffer + pointMIndex)));
+
+        __m128 const jm_pos_xy = _mm_movelh_ps(j_pos_xy, m_pos_xy); // First argument goes low
+        __m128 lk_pos_xy = _mm_movelh_ps(l_pos_xy, k_pos_xy); // First argument goes low
+        __m128 const s0s1_dis_xy = _mm_sub_ps(lk_pos_xy, jm_pos_xy);
+        lk_pos_xy = _mm_shuffle_ps(lk_pos_xy, lk_pos_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 const s2s3_dis_xy = _mm_sub_ps(lk_pos_xy, jm_pos_xy);
+
+        __m128 const s0s1s2s3_dis_x = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0x88);
+        __m128 const s0s1s2s3_dis_y = _mm_shuffle_ps(s0s1_dis_xy, s2s3_dis_xy, 0xDD);
+
+        __m128 const sq_len =
+            _mm_add_ps(
+                _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_dis_x),
+                _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_dis_y));
+
+        __m128 const validMask = _mm_cmpneq_ps(sq_len, Zero); // SL==0 => 1/SL==0, to maintain "normalized == (0, 0)", as in vec2f
+
+        __m128 const s0s1s2s3_springLength_inv =
+            _mm_and_ps(
+                _mm_rsqrt_ps(sq_len),
+                validMask);
+
+        __m128 const s0s1s2s3_springLength =
+            _mm_and_ps(
+                _mm_rcp_ps(s0s1s2s3_springLength_inv),
+                validMask);
+
+        __m128 const s0s1s2s3_sdir_x = _mm_mul_ps(s0s1s2s3_dis_x, s0s1s2s3_springLength_inv);
+        __m128 const s0s1s2s3_sdir_y = _mm_mul_ps(s0s1s2s3_dis_y, s0s1s2s3_springLength_inv);
+
+        //
+        // Load and convert spring constants: four halves each
+        //
+
+        __m128 const s0s1s2s3_restLength = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(restLengthBuffer + s)));
+        __m128 const s0s1s2s3_stiffness = _mm_mul_ps(
+            _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(stiffnessCoefficientBuffer + s))),
+            StiffnessCoefficientScale);
+        __m128 const s0s1s2s3_dampingCoeff = _mm_mul_ps(
+            _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(dampingCoefficientBuffer + s))),
+            DampingCoefficientScale);
+
+        //
+        // 1. Hooke's law
+        //
+
+        __m128 const s0s1s2s3_hooke_forceModuli =
+            _mm_mul_ps(
+                _mm_sub_ps(
+                    s0s1s2s3_springLength,
+                    s0s1s2s3_restLength),
+                s0s1s2s3_stiffness);
+
+        //
+        // 2. Damper forces
+        //
+
+        __m128 const j_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointJIndex)));
+        __m128 const k_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointKIndex)));
+        __m128 const l_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointLIndex)));
+        __m128 const m_vel_xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointVelocityBuffer + pointMIndex)));
+
+        __m128 const jm_vel_xy = _mm_movelh_ps(j_vel_xy, m_vel_xy); // First argument goes low
+        __m128 lk_vel_xy = _mm_movelh_ps(l_vel_xy, k_vel_xy); // First argument goes low
+        __m128 const s0s1_rvel_xy = _mm_sub_ps(lk_vel_xy, jm_vel_xy);
+        lk_vel_xy = _mm_shuffle_ps(lk_vel_xy, lk_vel_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 const s2s3_rvel_xy = _mm_sub_ps(lk_vel_xy, jm_vel_xy);
+
+        __m128 const s0s1s2s3_rvel_x = _mm_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0x88);
+        __m128 const s0s1s2s3_rvel_y = _mm_shuffle_ps(s0s1_rvel_xy, s2s3_rvel_xy, 0xDD);
+
+        __m128 const s0s1s2s3_damping_forceModuli =
+            _mm_mul_ps(
+                _mm_add_ps( // Dot product
+                    _mm_mul_ps(s0s1s2s3_rvel_x, s0s1s2s3_sdir_x),
+                    _mm_mul_ps(s0s1s2s3_rvel_y, s0s1s2s3_sdir_y)),
+                s0s1s2s3_dampingCoeff);
+
+        //
+        // 3. Apply forces
+        //
+
+        __m128 const tForceModuli = _mm_add_ps(s0s1s2s3_hooke_forceModuli, s0s1s2s3_damping_forceModuli);
+
+        __m128 const s0s1s2s3_tforceA_x = _mm_mul_ps(s0s1s2s3_sdir_x, tForceModuli);
+        __m128 const s0s1s2s3_tforceA_y = _mm_mul_ps(s0s1s2s3_sdir_y, tForceModuli);
+
+        __m128 s0s1_tforceA_xy = _mm_unpacklo_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[0], b[0], a[1], b[1]
+        __m128 s2s3_tforceA_xy = _mm_unpackhi_ps(s0s1s2s3_tforceA_x, s0s1s2s3_tforceA_y); // a[2], b[2], a[3], b[3]
+
+        __m128 const jm_sforce_xy = _mm_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+        s2s3_tforceA_xy = _mm_shuffle_ps(s2s3_tforceA_xy, s2s3_tforceA_xy, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128 const lk_sforce_xy = _mm_add_ps(s0s1_tforceA_xy, s2s3_tforceA_xy);
+
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), jm_sforce_xy);
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[2])), lk_sforce_xy);
+
+        pointSpringForceBuffer[pointJIndex] += tmpSpringForces[0];
+        pointSpringForceBuffer[pointMIndex] += tmpSpringForces[1];
+        pointSpringForceBuffer[pointLIndex] -= tmpSpringForces[2];
+        pointSpringForceBuffer[pointKIndex] -= tmpSpringForces[3];
+    }
+}
@@ -0,0 +1,83 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+
+#include "Buffer.h"
+#include "Simulator/Common/ISimulator.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * with the per-spring constants of perfect squares - rest length,
+ * stiffness, and damping coefficients - stored as IEEE half floats,
+ * and converted in registers with F16C.
+ *
+ * Falls back to the full-precision SSE implementation when the CPU
+ * does not support F16C.
+ */
+
+class FSBySpringStructuralIntrinsicsFP16Simulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 32 - By Spring - Structural Instrinsics - FP16";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsFP16Simulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+private:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    FS_TARGET_F16C void CreateHalfState(Object const & object);
+
+    void ApplySpringsForces(
+        Object const & object,
+        ThreadManager & threadManager) override;
+
+    FS_TARGET_F16C void ApplySpringsForcesFP16(
+        Object const & object,
+        vec2f * restrict pointSpringForceBuffer,
+        ElementIndex startSpringIndex,
+        ElementCount endSpringIndexPerfectSquare); // Excluded
+
+private:
+
+    bool const mIsF16CSupported;
+
+    //
+    // Perfect square spring buffers, as halves
+    //
+
+    Buffer<std::uint16_t> mSpringRestLengthHalfBuffer;
+    Buffer<std::uint16_t> mSpringStiffnessCoefficientHalfBuffer;
+    Buffer<std::uint16_t> mSpringDampingCoefficientHalfBuffer;
+
+    // Coefficients are stored divided by these powers of two, so
+    // that they fit the (narrow) range of halves
+    float mSpringStiffnessCoefficientScale;
+    float mSpringDampingCoefficientScale;
+};
@@ -0,0 +1,163 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsFusedSimulator.h"
+
+#include "Log.h"
+
+#include <cassert>
+#include <cmath>
+
+/*
+ * The "Striping" layout optimizer lays out points row by row, and springs by the
+ * lowest row of their endpoints; since springs only connect adjacent rows, the
+ * springs of row r touch the points of rows r and r+1 only.
+ *
+ * Hence, once the springs of row r have been relaxed, the points of row r have
+ * received all of their forces - from the springs of rows r-1 and r - and may be
+ * integrated right away; moreover, no spring that is yet to be relaxed in this
+ * iteration reads their positions or velocities.
+ *
+ * This way we make one single pass over the force buffer per iteration, and the
+ * forces of a row are integrated while still in the cache.
+ */
+
+FSBySpringStructuralIntrinsicsFusedSimulator::FSBySpringStructuralIntrinsicsFusedSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager,
+        0) // Perfect squares are spread among rows, and we always tell the kernel where they end
+    , mRows()
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsFusedSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & /*threadManager*/)
+{
+    size_t const numMechanicalDynamicsIterations = simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations;
+
+    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(numMechanicalDynamicsIterations);
+
+    float const globalDamping =
+        1.0f -
+        pow((1.0f - simulationParameters.FSCommonSimulator.GlobalDamping),
+            12.0f / static_cast<float>(numMechanicalDynamicsIterations));
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    float const velocityFactor = (1.0f - globalDamping) / dt;
+
+    for (size_t i = 0; i < numMechanicalDynamicsIterations; ++i)
+    {
+        for (size_t r = 0; r < mRows.size(); ++r)
+        {
+            UpdateRow(object, r, dt, velocityFactor);
+        }
+    }
+}
+
+void FSBySpringStructuralIntrinsicsFusedSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsSimulator::CreateState(object, simulationParameters, threadManager);
+
+    mRows.clear();
+
+    auto const & pointBlockSizes = object.GetSimulatorSpecificStructure().PointProcessingBlockSizes;
+    auto const & springBlockSizes = object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes;
+    assert(springBlockSizes.size() == pointBlockSizes.size() * 2);
+
+    size_t const numberOfRows = pointBlockSizes.size();
+
+    ElementIndex pointStart = 0;
+    ElementIndex springStart = 0;
+    for (size_t r = 0; r < numberOfRows; ++r)
+    {
+        ElementIndex const springEndPerfectSquare = springStart + springBlockSizes[r * 2] * 4;
+        ElementIndex const springEnd = springEndPerfectSquare + springBlockSizes[r * 2 + 1];
+
+        ElementIndex const pointEnd = (r < numberOfRows - 1)
+            ? pointStart + pointBlockSizes[r]
+            : static_cast<ElementIndex>(object.GetPoints().GetBufferElementCount()); // Last row also takes care of padding points
+
+        mRows.emplace_back(springStart, springEndPerfectSquare, springEnd, pointStart, pointEnd);
+
+        pointStart = pointEnd;
+        springStart = springEnd;
+    }
+
+    assert(springStart == object.GetSprings().GetElementCount());
+
+    LogMessage("FSBySpringStructuralIntrinsicsFusedSimulator: numSprings=", object.GetSprings().GetElementCount(), " numRows=", numberOfRows);
+}
+
+void FSBySpringStructuralIntrinsicsFusedSimulator::UpdateRow(
+    Object & object,
+    size_t row,
+    float dt,
+    float velocityFactor)
+{
+    RowInfo const & rowInfo = mRows[row];
+
+    // Apply spring forces of this row
+    FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
+        object,
+        mPointSpringForceBuffer.data(),
+        rowInfo.StartSpringIndex,
+        rowInfo.EndSpringIndexPerfectSquare,
+        rowInfo.EndSpringIndex);
+
+    // This row's points are complete now: integrate spring and external forces,
+    // and reset spring forces
+    IntegrateAndResetSpringForcesRange(
+        object,
+        rowInfo.StartPointIndex,
+        rowInfo.EndPointIndex,
+        dt,
+        velocityFactor);
+}
+
+void FSBySpringStructuralIntrinsicsFusedSimulator::IntegrateAndResetSpringForcesRange(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float dt,
+    float velocityFactor)
+{
+    float * const restrict positionBuffer = reinterpret_cast<float *>(object.GetPoints().GetPositionBuffer() + startPointIndex);
+    float * const restrict velocityBuffer = reinterpret_cast<float *>(object.GetPoints().GetVelocityBuffer() + startPointIndex);
+    float * const restrict springForceBuffer = reinterpret_cast<float *>(mPointSpringForceBuffer.data() + startPointIndex);
+    float const * const restrict externalForceBuffer = reinterpret_cast<float *>(mPointExternalForceBuffer.data() + startPointIndex);
+    float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data() + startPointIndex);
+
+    size_t const count = (endPointIndex - startPointIndex) * 2; // Two components per vector
+    for (size_t i = 0; i < count; ++i)
+    {
+        //
+        // Verlet integration (fourth order, with velocity being first order)
+        //
+
+        float const deltaPos =
+            velocityBuffer[i] * dt
+            + (springForceBuffer[i] + externalForceBuffer[i]) * integrationFactorBuffer[i];
+
+        positionBuffer[i] += deltaPos;
+        velocityBuffer[i] = deltaPos * velocityFactor;
+
+        // Zero out spring force now that we've integrated it
+        springForceBuffer[i] = 0.0f;
+    }
+}
@@ -0,0 +1,96 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+#include "FSBySpringStructuralIntrinsicsMTStripedSimulator.h"
+
+#include "Simulator/Common/ISimulator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * fusing spring relaxation and integration in one single pass:
+ * objects are processed row by row, and the points of a row are
+ * integrated as soon as all of their springs have been relaxed,
+ * while their forces are still in the cache.
+ */
+
+class FSBySpringStructuralIntrinsicsFusedSimulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 30 - By Spring - Structural Instrinsics - Fused";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsStripingLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsFusedSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+protected:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    // Relaxes the springs of the row, and then integrates the points of the row
+    void UpdateRow(
+        Object & object,
+        size_t row,
+        float dt,
+        float velocityFactor);
+
+    void IntegrateAndResetSpringForcesRange(
+        Object & object,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float dt,
+        float velocityFactor);
+
+protected:
+
+    struct RowInfo
+    {
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndexPerfectSquare; // Excluded
+        ElementIndex EndSpringIndex; // Excluded
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+
+        RowInfo(
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndexPerfectSquare,
+            ElementIndex endSpringIndex,
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex)
+            : StartSpringIndex(startSpringIndex)
+            , EndSpringIndexPerfectSquare(endSpringIndexPerfectSquare)
+            , EndSpringIndex(endSpringIndex)
+            , StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+        {}
+    };
+
+    std::vector<RowInfo> mRows;
+};
@@ -0,0 +1,487 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsMTColoredSimulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+/*
+ * An update is one single ThreadPool batch, in which each thread runs all the
+ * mechanical dynamics iterations:
+ *
+ *  for each iteration:
+ *      for each color:
+ *          relax own springs of this color into the (shared) force buffer
+ *          -- barrier --
+ *      integrate own points and reset their spring forces
+ *      -- barrier --
+ *
+ * Compared to the other MT simulators we have one barrier per color, but no
+ * per-thread force buffers - hence no reduction of all of those buffers at
+ * integration time, which is what prevents the other simulators from scaling
+ * past a few threads.
+ */
+
+FSBySpringStructuralIntrinsicsMTColoredSimulator::FSBySpringStructuralIntrinsicsMTColoredSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager,
+        0) // Perfect squares are spread among colors, and we always tell the kernel where they end
+    , mThreadStates()
+    , mParallelRegionTasks()
+    , mPhaseBarrier()
+    , mCurrentObject(nullptr)
+    , mNumMechanicalDynamicsIterations(0)
+    , mDt(0.0f)
+    , mVelocityFactor(0.0f)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsMTColoredSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Calculate parameters for this update
+    //
+
+    mNumMechanicalDynamicsIterations = simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations;
+
+    mDt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(mNumMechanicalDynamicsIterations);
+
+    float const globalDamping =
+        1.0f -
+        pow((1.0f - simulationParameters.FSCommonSimulator.GlobalDamping),
+            12.0f / static_cast<float>(mNumMechanicalDynamicsIterations));
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    mVelocityFactor = (1.0f - globalDamping) / mDt;
+
+    //
+    // Run parallel region
+    //
+
+    mCurrentObject = &object;
+
+    threadManager.GetSimulationThreadPool().Run(mParallelRegionTasks);
+
+    mCurrentObject = nullptr;
+}
+
+void FSBySpringStructuralIntrinsicsMTColoredSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsSimulator::CreateState(object, simulationParameters, threadManager);
+
+    // Clear threading state
+    mThreadStates.clear();
+    mParallelRegionTasks.clear();
+
+    // Number of 4-spring blocks per thread, assuming we use all parallelism
+    ElementCount const numberOfSprings = static_cast<ElementCount>(object.GetSprings().GetElementCount());
+    ElementCount const numberOfFourSpringsPerThread = numberOfSprings / (static_cast<ElementCount>(threadManager.GetSimulationParallelism()) * 4);
+
+    size_t parallelism;
+    if (numberOfFourSpringsPerThread > 0)
+    {
+        parallelism = threadManager.GetSimulationParallelism();
+    }
+    else
+    {
+        // Not enough, use just one thread
+        parallelism = 1;
+    }
+
+    // Number of points per thread, rounded to a couple of cache lines
+    // so that threads don't share cache lines while integrating
+    ElementCount constexpr PointGranularity = 16;
+    ElementCount const numberOfPoints = static_cast<ElementCount>(object.GetPoints().GetBufferElementCount());
+    static_assert((PointGranularity % vectorization_float_count<ElementCount>) == 0);
+    ElementCount const numberOfPointsPerThread =
+        (numberOfPoints / static_cast<ElementCount>(parallelism) + PointGranularity - 1) / PointGranularity * PointGranularity;
+
+    ElementIndex pointStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const pointEnd = (t < parallelism - 1)
+            ? std::min(pointStart + numberOfPointsPerThread, numberOfPoints)
+            : numberOfPoints;
+
+        mThreadStates.emplace_back(pointStart, pointEnd);
+
+        mParallelRegionTasks.emplace_back(
+            [this, t]()
+            {
+                assert(mCurrentObject != nullptr);
+
+                RunParallelRegion(
+                    *mCurrentObject,
+                    t);
+            });
+
+        pointStart = pointEnd;
+    }
+
+    //
+    // Split each color among threads, in units of one perfect square or
+    // four leftover springs
+    //
+
+    auto const & springBlockSizes = object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes;
+    assert((springBlockSizes.size() % 2) == 1);
+
+    size_t const numberOfColors = springBlockSizes.size() / 2;
+
+    ElementIndex colorStart = 0;
+    for (size_t c = 0; c < numberOfColors; ++c)
+    {
+        ElementCount const colorPerfectSquareCount = springBlockSizes[c * 2];
+        ElementCount const colorLeftoverSpringCount = springBlockSizes[c * 2 + 1];
+
+        ElementIndex const colorEndPerfectSquare = colorStart + colorPerfectSquareCount * 4;
+        ElementIndex const colorEnd = colorEndPerfectSquare + colorLeftoverSpringCount;
+        assert((colorEnd % 4) == 0);
+
+        ElementCount const numberOfUnits = colorPerfectSquareCount + colorLeftoverSpringCount / 4;
+
+        for (size_t t = 0; t < parallelism; ++t)
+        {
+            ElementIndex const unitStart = static_cast<ElementIndex>(numberOfUnits * t / parallelism);
+            ElementIndex const unitEnd = static_cast<ElementIndex>(numberOfUnits * (t + 1) / parallelism);
+
+            ElementIndex const springStart = colorStart + unitStart * 4;
+            ElementIndex const springEnd = colorStart + unitEnd * 4;
+
+            mThreadStates[t].ColorSpringRanges.emplace_back(
+                springStart,
+                std::min(springEnd, colorEndPerfectSquare),
+                springEnd);
+        }
+
+        colorStart = colorEnd;
+    }
+
+    // Serial springs - if any - are all relaxed by the first thread
+    ElementCount const serialSpringCount = springBlockSizes.back();
+    if (serialSpringCount > 0)
+    {
+        for (size_t t = 0; t < parallelism; ++t)
+        {
+            ElementIndex const springStart = (t == 0) ? colorStart : colorStart + serialSpringCount;
+
+            mThreadStates[t].ColorSpringRanges.emplace_back(
+                springStart,
+                springStart,
+                colorStart + serialSpringCount);
+        }
+    }
+
+    assert(colorStart + serialSpringCount == numberOfSprings);
+
+    mPhaseBarrier.Reset(parallelism);
+
+    LogMessage("FSBySpringStructuralIntrinsicsMTColoredSimulator: numSprings=", object.GetSprings().GetElementCount(), " numColors=", numberOfColors,
+        " serialSpringCount=", serialSpringCount, " numberOfPointsPerThread=", numberOfPointsPerThread, " numThreads=", parallelism);
+}
+
+void FSBySpringStructuralIntrinsicsMTColoredSimulator::RunParallelRegion(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState const & threadState = mThreadStates[threadIndex];
+
+    for (size_t i = 0; i < mNumMechanicalDynamicsIterations; ++i)
+    {
+        for (SpringRange const & springRange : threadState.ColorSpringRanges)
+        {
+            // Apply spring forces of this color
+            FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
+                object,
+                mPointSpringForceBuffer.data(),
+                springRange.StartSpringIndex,
+                springRange.EndSpringIndexPerfectSquare,
+                springRange.EndSpringIndex);
+
+            // Wait for all forces of this color to be in
+            mPhaseBarrier.ArriveAndWait();
+        }
+
+        // Integrate spring and external forces,
+        // and reset spring forces
+        IntegrateAndResetSpringForcesRange(
+            object,
+            threadState.StartPointIndex,
+            threadState.EndPointIndex);
+
+        // Wait for all positions to be in, unless this is the last iteration,
+        // in which case the end of the batch does it for us
+        if (i < mNumMechanicalDynamicsIterations - 1)
+        {
+            mPhaseBarrier.ArriveAndWait();
+        }
+    }
+}
+
+void FSBySpringStructuralIntrinsicsMTColoredSimulator::IntegrateAndResetSpringForcesRange(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    float * const restrict positionBuffer = reinterpret_cast<float *>(object.GetPoints().GetPositionBuffer());
+    float * const restrict velocityBuffer = reinterpret_cast<float *>(object.GetPoints().GetVelocityBuffer());
+    float * const restrict springForceBuffer = reinterpret_cast<float *>(mPointSpringForceBuffer.data());
+    float const * const restrict externalForceBuffer = reinterpret_cast<float *>(mPointExternalForceBuffer.data());
+    float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data());
+
+    assert((startPointIndex % 2) == 0);
+    assert((endPointIndex % 2) == 0);
+    size_t const start = startPointIndex * 2; // Two components per vector
+    size_t const end = endPointIndex * 2; // Two components per vector
+
+    __m128 const zero_4 = _mm_setzero_ps();
+    __m128 const dt_4 = _mm_load1_ps(&mDt);
+    __m128 const velocityFactor_4 = _mm_load1_ps(&mVelocityFactor);
+
+    for (size_t p = start; p < end; p += 4)
+    {
+        // vec2f const deltaPos =
+        //    velocityBuffer[i] * dt
+        //    + (springForceBuffer[i] + externalForceBuffer[i]) * integrationFactorBuffer[i];
+        __m128 const deltaPos_2 =
+            _mm_add_ps(
+                _mm_mul_ps(
+                    _mm_load_ps(velocityBuffer + p),
+                    dt_4),
+                _mm_mul_ps(
+                    _mm_add_ps(
+                        _mm_load_ps(springForceBuffer + p),
+                        _mm_load_ps(externalForceBuffer + p)),
+                    _mm_load_ps(integrationFactorBuffer + p)));
+
+        // positionBuffer[i] += deltaPos;
+        __m128 pos_2 = _mm_load_ps(positionBuffer + p);
+        pos_2 = _mm_add_ps(pos_2, deltaPos_2);
+        _mm_store_ps(positionBuffer + p, pos_2);
+
+        // velocityBuffer[i] = deltaPos * velocityFactor;
+        __m128 const vel_2 =
+            _mm_mul_ps(
+                deltaPos_2,
+                velocityFactor_4);
+        _mm_store_ps(velocityBuffer + p, vel_2);
+
+        // Zero out spring force now that we've integrated it
+        _mm_store_ps(springForceBuffer + p, zero_4);
+    }
+}
+
+/////////////////////////////////////////////////
+
+ILayoutOptimizer::LayoutRemap FSBySpringStructuralIntrinsicsColoringLayoutOptimizer::Remap(
+    ObjectBuildPointIndexMatrix const & pointMatrix,
+    std::vector<ObjectBuildPoint> const & points,
+    std::vector<ObjectBuildSpring> const & springs) const
+{
+    //
+    // 1. Start from the structural layout: perfect squares first, then leftovers
+    //
+
+    LayoutRemap structuralRemap = FSBySpringStructuralIntrinsicsLayoutOptimizer().Remap(pointMatrix, points, springs);
+
+    IndexRemap const & structuralSpringRemap = structuralRemap.SpringRemap;
+
+    assert(structuralRemap.SimulatorSpecificStructure.SpringProcessingBlockSizes.size() == 1);
+    ElementCount const perfectSquareCount = structuralRemap.SimulatorSpecificStructure.SpringProcessingBlockSizes[0];
+
+    //
+    // 2. Greedily color perfect squares and leftover springs, so that no two
+    //    elements of the same color share a point
+    //
+    // Elements are referred to via their index in the structural layout; points
+    // are referred to via their original index
+    //
+
+    struct Color
+    {
+        std::vector<ElementIndex> PerfectSquares; // Index of first spring
+        std::vector<ElementIndex> LeftoverSprings;
+        std::vector<bool> PointMask;
+
+        explicit Color(size_t pointCount)
+            : PerfectSquares()
+            , LeftoverSprings()
+            , PointMask(pointCount, false)
+        {}
+    };
+
+    std::vector<Color> colors;
+
+    auto const isColorAvailable = [&](auto const & elementPoints, size_t c) -> bool
+    {
+        return std::none_of(
+            elementPoints.cbegin(),
+            elementPoints.cend(),
+            [&](ElementIndex p) { return colors[c].PointMask[p]; });
+    };
+
+    auto const addToColor = [&](auto const & elementPoints, size_t c)
+    {
+        for (ElementIndex p : elementPoints)
+        {
+            colors[c].PointMask[p] = true;
+        }
+    };
+
+    auto const findColor = [&](auto const & elementPoints) -> size_t
+    {
+        size_t c = 0;
+        for (; c < colors.size(); ++c)
+        {
+            if (isColorAvailable(elementPoints, c))
+            {
+                break;
+            }
+        }
+
+        if (c == colors.size())
+        {
+            colors.emplace_back(points.size());
+        }
+
+        addToColor(elementPoints, c);
+
+        return c;
+    };
+
+    auto const getSpringPoints = [&](ElementIndex s) -> std::array<ElementIndex, 2>
+    {
+        return {
+            springs[structuralSpringRemap.NewToOld(s)].PointAIndex,
+            springs[structuralSpringRemap.NewToOld(s)].PointBIndex };
+    };
+
+    for (ElementIndex sq = 0; sq < perfectSquareCount; ++sq)
+    {
+        ElementIndex const s = sq * 4;
+
+        // The two cross springs touch all of the four points
+        auto const crossSpring1Points = getSpringPoints(s);
+        auto const crossSpring2Points = getSpringPoints(s + 1);
+        std::array<ElementIndex, 4> const squarePoints{
+            crossSpring1Points[0],
+            crossSpring1Points[1],
+            crossSpring2Points[0],
+            crossSpring2Points[1] };
+
+        size_t const c = findColor(squarePoints);
+        colors[c].PerfectSquares.push_back(s);
+    }
+
+    for (ElementIndex s = perfectSquareCount * 4; s < springs.size(); ++s)
+    {
+        size_t const c = findColor(getSpringPoints(s));
+        colors[c].LeftoverSprings.push_back(s);
+    }
+
+    //
+    // 3. Make each color a multiple of 4 springs, by moving excess leftover springs
+    //    to subsequent colors - or, when they don't fit anywhere, to the serial block
+    //
+
+    std::vector<ElementIndex> serialSprings;
+
+    for (size_t c = 0; c < colors.size(); ++c)
+    {
+        while ((colors[c].LeftoverSprings.size() % 4) != 0)
+        {
+            ElementIndex const s = colors[c].LeftoverSprings.back();
+            colors[c].LeftoverSprings.pop_back();
+
+            auto const springPoints = getSpringPoints(s);
+
+            size_t newC = c + 1;
+            for (; newC < colors.size(); ++newC)
+            {
+                if (isColorAvailable(springPoints, newC))
+                {
+                    break;
+                }
+            }
+
+            if (newC < colors.size())
+            {
+                addToColor(springPoints, newC);
+                colors[newC].LeftoverSprings.push_back(s);
+            }
+            else
+            {
+                serialSprings.push_back(s);
+            }
+        }
+    }
+
+    //
+    // 4. Lay out springs color by color
+    //
+
+    IndexRemap optimalSpringRemap(springs.size());
+    ObjectSimulatorSpecificStructure simulatorSpecificStructure;
+
+    for (Color const & color : colors)
+    {
+        for (ElementIndex s : color.PerfectSquares)
+        {
+            for (ElementIndex i = 0; i < 4; ++i)
+            {
+                optimalSpringRemap.AddOld(structuralSpringRemap.NewToOld(s + i));
+            }
+        }
+
+        for (ElementIndex s : color.LeftoverSprings)
+        {
+            optimalSpringRemap.AddOld(structuralSpringRemap.NewToOld(s));
+        }
+
+        simulatorSpecificStructure.SpringProcessingBlockSizes.emplace_back(static_cast<ElementCount>(color.PerfectSquares.size()));
+        simulatorSpecificStructure.SpringProcessingBlockSizes.emplace_back(static_cast<ElementCount>(color.LeftoverSprings.size()));
+    }
+
+    for (ElementIndex s : serialSprings)
+    {
+        optimalSpringRemap.AddOld(structuralSpringRemap.NewToOld(s));
+    }
+
+    simulatorSpecificStructure.SpringProcessingBlockSizes.emplace_back(static_cast<ElementCount>(serialSprings.size()));
+
+    LogMessage("ColoringLayoutOptimizer: ", colors.size(), " colors, ", serialSprings.size(), " serial springs");
+
+    // Points and endpoint flips stay as in the structural layout
+    return LayoutRemap(
+        std::move(structuralRemap.PointRemap),
+        std::move(optimalSpringRemap),
+        std::move(structuralRemap.SpringEndpointFlipMask),
+        std::move(simulatorSpecificStructure));
+}
@@ -0,0 +1,134 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+
+#include "Simulator/Common/ISimulator.h"
+#include "ThreadBarrier.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * with multiple threads that all accumulate spring forces into
+ * one single force buffer.
+ *
+ * The layout optimizer partitions springs into "colors", i.e.
+ * sets of springs - and perfect squares - that share no endpoints;
+ * threads relax one color at a time, and thus never write to the
+ * same point concurrently.
+ */
+
+class FSBySpringStructuralIntrinsicsColoringLayoutOptimizer;
+
+class FSBySpringStructuralIntrinsicsMTColoredSimulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 17 - By Spring - Structural Instrinsics - MT - Colored";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsColoringLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsMTColoredSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void RunParallelRegion(
+        Object & object,
+        size_t threadIndex);
+
+    void IntegrateAndResetSpringForcesRange(
+        Object & object,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex); // Excluded
+
+private:
+
+    struct SpringRange
+    {
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndexPerfectSquare; // Excluded
+        ElementIndex EndSpringIndex; // Excluded
+
+        SpringRange(
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndexPerfectSquare,
+            ElementIndex endSpringIndex)
+            : StartSpringIndex(startSpringIndex)
+            , EndSpringIndexPerfectSquare(endSpringIndexPerfectSquare)
+            , EndSpringIndex(endSpringIndex)
+        {}
+    };
+
+    struct ThreadState
+    {
+        std::vector<SpringRange> ColorSpringRanges; // One per color, plus one for the serial springs if any
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+
+        ThreadState(
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex)
+            : ColorSpringRanges()
+            , StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+        {}
+    };
+
+    std::vector<ThreadState> mThreadStates;
+    std::vector<typename ThreadPool::Task> mParallelRegionTasks;
+    ThreadBarrier mPhaseBarrier;
+
+    // Current update's object and parameters
+    Object * mCurrentObject;
+    size_t mNumMechanicalDynamicsIterations;
+    float mDt;
+    float mVelocityFactor;
+};
+
+/*
+ * Lays out springs as the "Structural Intrinsics" layout optimizer does, and then
+ * re-arranges them into colors, each color being a sequence of perfect squares
+ * followed by leftover springs. All colors have a number of leftover springs which
+ * is a multiple of 4, so that each color begins at a vectorization boundary; the
+ * few springs that cannot be fit anywhere while keeping this property end up in
+ * a final "serial" block, which may only be relaxed by one thread.
+ *
+ * Simulator-specific structure: for each color, the number of perfect squares
+ * followed by the number of leftover springs; then, the number of serial springs.
+ */
+class FSBySpringStructuralIntrinsicsColoringLayoutOptimizer : public ILayoutOptimizer
+{
+public:
+
+    LayoutRemap Remap(
+        ObjectBuildPointIndexMatrix const & pointMatrix,
+        std::vector<ObjectBuildPoint> const & points,
+        std::vector<ObjectBuildSpring> const & springs) const override;
+};
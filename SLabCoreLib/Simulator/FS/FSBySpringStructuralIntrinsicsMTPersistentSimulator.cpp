@@ -0,0 +1,261 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsMTPersistentSimulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+/*
+ * Each thread owns a range of springs - as in the other MT simulators - and a range
+ * of points. An update is one single ThreadPool batch, in which each thread runs all
+ * the mechanical dynamics iterations:
+ *
+ *  for each iteration:
+ *      relax own springs into own force buffer
+ *      -- barrier --
+ *      integrate own points, summing up the force buffers of all threads, and reset them
+ *      -- barrier --
+ *
+ * This saves waking up the pool at each iteration, and parallelizes integration.
+ */
+
+FSBySpringStructuralIntrinsicsMTPersistentSimulator::FSBySpringStructuralIntrinsicsMTPersistentSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mThreadStates()
+    , mParallelRegionTasks()
+    , mPhaseBarrier()
+    , mPointSpringForceBuffers()
+    , mPointSpringForceBuffersVectorized()
+    , mCurrentObject(nullptr)
+    , mNumMechanicalDynamicsIterations(0)
+    , mDt(0.0f)
+    , mVelocityFactor(0.0f)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsMTPersistentSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Calculate parameters for this update
+    //
+
+    mNumMechanicalDynamicsIterations = simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations;
+
+    mDt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(mNumMechanicalDynamicsIterations);
+
+    float const globalDamping =
+        1.0f -
+        pow((1.0f - simulationParameters.FSCommonSimulator.GlobalDamping),
+            12.0f / static_cast<float>(mNumMechanicalDynamicsIterations));
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    mVelocityFactor = (1.0f - globalDamping) / mDt;
+
+    //
+    // Run parallel region
+    //
+
+    mCurrentObject = &object;
+
+    threadManager.GetSimulationThreadPool().Run(mParallelRegionTasks);
+
+    mCurrentObject = nullptr;
+}
+
+void FSBySpringStructuralIntrinsicsMTPersistentSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsSimulator::CreateState(object, simulationParameters, threadManager);
+
+    // Clear threading state
+    mThreadStates.clear();
+    mParallelRegionTasks.clear();
+    mPointSpringForceBuffers.clear();
+    mPointSpringForceBuffersVectorized.clear();
+
+    // Number of 4-spring blocks per thread, assuming we use all parallelism
+    ElementCount const numberOfSprings = static_cast<ElementCount>(object.GetSprings().GetElementCount());
+    ElementCount const numberOfFourSpringsPerThread = numberOfSprings / (static_cast<ElementCount>(threadManager.GetSimulationParallelism()) * 4);
+
+    size_t parallelism;
+    if (numberOfFourSpringsPerThread > 0)
+    {
+        parallelism = threadManager.GetSimulationParallelism();
+    }
+    else
+    {
+        // Not enough, use just one thread
+        parallelism = 1;
+    }
+
+    // Number of points per thread, rounded to a couple of cache lines
+    // so that threads don't share cache lines while integrating
+    ElementCount constexpr PointGranularity = 16;
+    ElementCount const numberOfPoints = static_cast<ElementCount>(object.GetPoints().GetBufferElementCount());
+    static_assert((PointGranularity % vectorization_float_count<ElementCount>) == 0);
+    ElementCount const numberOfPointsPerThread =
+        (numberOfPoints / static_cast<ElementCount>(parallelism) + PointGranularity - 1) / PointGranularity * PointGranularity;
+
+    ElementIndex springStart = 0;
+    ElementIndex pointStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const springEnd = (t < parallelism - 1)
+            ? springStart + numberOfFourSpringsPerThread * 4
+            : numberOfSprings;
+
+        ElementIndex const pointEnd = (t < parallelism - 1)
+            ? std::min(pointStart + numberOfPointsPerThread, numberOfPoints)
+            : numberOfPoints;
+
+        mThreadStates.emplace_back(springStart, springEnd, pointStart, pointEnd);
+
+        // Create helper buffer for this thread
+        mPointSpringForceBuffers.emplace_back(object.GetPoints().GetBufferElementCount(), 0, vec2f::zero());
+        mPointSpringForceBuffersVectorized.emplace_back(reinterpret_cast<float *>(mPointSpringForceBuffers.back().data()));
+
+        mParallelRegionTasks.emplace_back(
+            [this, t]()
+            {
+                assert(mCurrentObject != nullptr);
+
+                RunParallelRegion(
+                    *mCurrentObject,
+                    t);
+            });
+
+        springStart = springEnd;
+        pointStart = pointEnd;
+    }
+
+    mPhaseBarrier.Reset(parallelism);
+
+    LogMessage("FSBySpringStructuralIntrinsicsMTPersistentSimulator: numSprings=", object.GetSprings().GetElementCount(), " springPerfectSquareCount=", mSpringPerfectSquareCount,
+        " numberOfFourSpringsPerThread=", numberOfFourSpringsPerThread, " numberOfPointsPerThread=", numberOfPointsPerThread, " numThreads=", parallelism);
+}
+
+void FSBySpringStructuralIntrinsicsMTPersistentSimulator::RunParallelRegion(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState const & threadState = mThreadStates[threadIndex];
+
+    for (size_t i = 0; i < mNumMechanicalDynamicsIterations; ++i)
+    {
+        // Apply spring forces
+        FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
+            object,
+            mPointSpringForceBuffers[threadIndex].data(),
+            threadState.StartSpringIndex,
+            threadState.EndSpringIndex);
+
+        // Wait for all forces to be in
+        mPhaseBarrier.ArriveAndWait();
+
+        // Integrate spring and external forces,
+        // and reset spring forces
+        IntegrateAndResetSpringForcesRange(
+            object,
+            threadState.StartPointIndex,
+            threadState.EndPointIndex);
+
+        // Wait for all positions to be in, unless this is the last iteration,
+        // in which case the end of the batch does it for us
+        if (i < mNumMechanicalDynamicsIterations - 1)
+        {
+            mPhaseBarrier.ArriveAndWait();
+        }
+    }
+}
+
+void FSBySpringStructuralIntrinsicsMTPersistentSimulator::IntegrateAndResetSpringForcesRange(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    float * const restrict positionBuffer = reinterpret_cast<float *>(object.GetPoints().GetPositionBuffer());
+    float * const restrict velocityBuffer = reinterpret_cast<float *>(object.GetPoints().GetVelocityBuffer());
+    float const * const restrict externalForceBuffer = reinterpret_cast<float *>(mPointExternalForceBuffer.data());
+    float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data());
+
+    size_t const nBuffers = mPointSpringForceBuffersVectorized.size();
+    float * const restrict * restrict const pointSpringForceBufferOfBuffers = mPointSpringForceBuffersVectorized.data();
+
+    assert((startPointIndex % 2) == 0);
+    assert((endPointIndex % 2) == 0);
+    size_t const start = startPointIndex * 2; // Two components per vector
+    size_t const end = endPointIndex * 2; // Two components per vector
+
+    __m128 const zero_4 = _mm_setzero_ps();
+    __m128 const dt_4 = _mm_load1_ps(&mDt);
+    __m128 const velocityFactor_4 = _mm_load1_ps(&mVelocityFactor);
+
+    for (size_t p = start; p < end; p += 4)
+    {
+        __m128 springForce_2 = zero_4;
+        for (size_t b = 0; b < nBuffers; ++b)
+        {
+            springForce_2 =
+                _mm_add_ps(
+                    springForce_2,
+                    _mm_load_ps(pointSpringForceBufferOfBuffers[b] + p));
+        }
+
+        // vec2f const deltaPos =
+        //    velocityBuffer[i] * dt
+        //    + (springForceBuffer[i] + externalForceBuffer[i]) * integrationFactorBuffer[i];
+        __m128 const deltaPos_2 =
+            _mm_add_ps(
+                _mm_mul_ps(
+                    _mm_load_ps(velocityBuffer + p),
+                    dt_4),
+                _mm_mul_ps(
+                    _mm_add_ps(
+                        springForce_2,
+                        _mm_load_ps(externalForceBuffer + p)),
+                    _mm_load_ps(integrationFactorBuffer + p)));
+
+        // positionBuffer[i] += deltaPos;
+        __m128 pos_2 = _mm_load_ps(positionBuffer + p);
+        pos_2 = _mm_add_ps(pos_2, deltaPos_2);
+        _mm_store_ps(positionBuffer + p, pos_2);
+
+        // velocityBuffer[i] = deltaPos * velocityFactor;
+        __m128 const vel_2 =
+            _mm_mul_ps(
+                deltaPos_2,
+                velocityFactor_4);
+        _mm_store_ps(velocityBuffer + p, vel_2);
+
+        for (size_t b = 0; b < nBuffers; ++b)
+        {
+            _mm_store_ps(pointSpringForceBufferOfBuffers[b] + p, zero_4);
+        }
+    }
+}
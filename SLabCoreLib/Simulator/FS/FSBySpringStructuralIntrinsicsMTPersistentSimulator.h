@@ -0,0 +1,101 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+
+#include "Buffer.h"
+#include "Simulator/Common/ISimulator.h"
+#include "ThreadBarrier.h"
+#include "Vectors.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * with multiple threads that stay in one single parallel region
+ * for all the mechanical dynamics iterations of an update, and
+ * which also integrate in parallel - each thread owning a range
+ * of points.
+ */
+
+class FSBySpringStructuralIntrinsicsMTPersistentSimulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 16 - By Spring - Structural Instrinsics - MT - Persistent";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsMTPersistentSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void RunParallelRegion(
+        Object & object,
+        size_t threadIndex);
+
+    void IntegrateAndResetSpringForcesRange(
+        Object & object,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex); // Excluded
+
+private:
+
+    struct ThreadState
+    {
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndex; // Excluded
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+
+        ThreadState(
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndex,
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex)
+            : StartSpringIndex(startSpringIndex)
+            , EndSpringIndex(endSpringIndex)
+            , StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+        {}
+    };
+
+    std::vector<ThreadState> mThreadStates;
+    std::vector<typename ThreadPool::Task> mParallelRegionTasks;
+    ThreadBarrier mPhaseBarrier;
+
+    std::vector<Buffer<vec2f>> mPointSpringForceBuffers;
+    std::vector<float * restrict> mPointSpringForceBuffersVectorized;
+
+    // Current update's object and parameters
+    Object * mCurrentObject;
+    size_t mNumMechanicalDynamicsIterations;
+    float mDt;
+    float mVelocityFactor;
+};
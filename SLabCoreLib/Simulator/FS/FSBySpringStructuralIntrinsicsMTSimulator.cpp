@@ -133,7 +133,7 @@ void FSBySpringStructuralIntrinsicsMTSimulator::ApplySpringsForces(
     static_assert(vectorization_float_count<int> >= 4);
 
     vec2f * const restrict pointSpringForceBuffer = mPointSpringForceBuffer.data();
-    ElementCount const pointCount = object.GetPoints().GetElementCount();
+    ElementCount const pointCount = object.GetPoints().GetBufferElementCount();
     assert(pointCount % vectorization_float_count<ElementCount> == 0);
     for (ElementIndex p = 0; p < pointCount; p += 4)
     {
@@ -0,0 +1,414 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsMTStripedSimulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+/*
+ * The layout optimizer lays out points and springs row by row; since springs only
+ * connect adjacent rows, the springs of a row only touch the points of that row and
+ * of the row above.
+ *
+ * Each thread owns a contiguous range of rows - a stripe - and thus a contiguous range
+ * of points and a contiguous range of springs. The springs of the stripe touch its own
+ * points and the first row of points of the next stripe, which is the stripe's halo.
+ * Each thread's force buffer only covers its points and its halo.
+ *
+ * An update is one single ThreadPool batch, in which each thread runs all the
+ * mechanical dynamics iterations:
+ *
+ *  for each iteration:
+ *      relax own springs into own force buffer
+ *      -- barrier --
+ *      add previous stripe's halo to own forces, integrate own points, and reset forces
+ *      -- barrier --
+ */
+
+FSBySpringStructuralIntrinsicsMTStripedSimulator::FSBySpringStructuralIntrinsicsMTStripedSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager,
+        0) // Perfect squares are spread among rows, and we always tell the kernel where they end
+    , mRows()
+    , mThreadStates()
+    , mParallelRegionTasks()
+    , mPhaseBarrier()
+    , mCurrentObject(nullptr)
+    , mNumMechanicalDynamicsIterations(0)
+    , mDt(0.0f)
+    , mVelocityFactor(0.0f)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsMTStripedSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Calculate parameters for this update
+    //
+
+    mNumMechanicalDynamicsIterations = simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations;
+
+    mDt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(mNumMechanicalDynamicsIterations);
+
+    float const globalDamping =
+        1.0f -
+        pow((1.0f - simulationParameters.FSCommonSimulator.GlobalDamping),
+            12.0f / static_cast<float>(mNumMechanicalDynamicsIterations));
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    mVelocityFactor = (1.0f - globalDamping) / mDt;
+
+    //
+    // Run parallel region
+    //
+
+    mCurrentObject = &object;
+
+    threadManager.GetSimulationThreadPool().Run(mParallelRegionTasks);
+
+    mCurrentObject = nullptr;
+}
+
+void FSBySpringStructuralIntrinsicsMTStripedSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsSimulator::CreateState(object, simulationParameters, threadManager);
+
+    // Clear threading state
+    mRows.clear();
+    mThreadStates.clear();
+    mParallelRegionTasks.clear();
+
+    //
+    // Rows
+    //
+
+    auto const & pointBlockSizes = object.GetSimulatorSpecificStructure().PointProcessingBlockSizes;
+    auto const & springBlockSizes = object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes;
+    assert(springBlockSizes.size() == pointBlockSizes.size() * 2);
+
+    size_t const numberOfRows = pointBlockSizes.size();
+
+    std::vector<ElementIndex> rowStartPointIndices;
+    rowStartPointIndices.reserve(numberOfRows + 1);
+
+    ElementIndex pointStart = 0;
+    ElementIndex springStart = 0;
+    for (size_t r = 0; r < numberOfRows; ++r)
+    {
+        ElementIndex const springEndPerfectSquare = springStart + springBlockSizes[r * 2] * 4;
+        ElementIndex const springEnd = springEndPerfectSquare + springBlockSizes[r * 2 + 1];
+
+        mRows.emplace_back(springStart, springEndPerfectSquare, springEnd);
+        rowStartPointIndices.emplace_back(pointStart);
+
+        pointStart += pointBlockSizes[r];
+        springStart = springEnd;
+    }
+
+    rowStartPointIndices.emplace_back(pointStart);
+
+    ElementCount const numberOfSprings = static_cast<ElementCount>(object.GetSprings().GetElementCount());
+    assert(springStart == numberOfSprings);
+    assert(pointStart == object.GetPoints().GetElementCount());
+
+    //
+    // Stripes
+    //
+
+    // Number of 4-spring blocks per thread, assuming we use all parallelism
+    ElementCount const numberOfFourSpringsPerThread = numberOfSprings / (static_cast<ElementCount>(threadManager.GetSimulationParallelism()) * 4);
+
+    size_t parallelism;
+    if (numberOfFourSpringsPerThread > 0)
+    {
+        // Each stripe needs at least one row
+        parallelism = std::min(threadManager.GetSimulationParallelism(), std::max(numberOfRows, size_t(1)));
+    }
+    else
+    {
+        // Not enough, use just one thread
+        parallelism = 1;
+    }
+
+    size_t rowStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        size_t rowEnd;
+        if (t < parallelism - 1)
+        {
+            // Balance springs among stripes, leaving at least one row to each subsequent stripe
+            ElementIndex const targetSpringEnd = static_cast<ElementIndex>(static_cast<size_t>(numberOfSprings) * (t + 1) / parallelism);
+
+            rowEnd = rowStart + 1;
+            while (rowEnd < numberOfRows - (parallelism - 1 - t) && mRows[rowEnd - 1].EndSpringIndex < targetSpringEnd)
+            {
+                ++rowEnd;
+            }
+        }
+        else
+        {
+            rowEnd = numberOfRows;
+        }
+
+        ElementIndex const stripePointStart = rowStartPointIndices[rowStart];
+
+        ElementIndex const stripePointEnd = (t < parallelism - 1)
+            ? rowStartPointIndices[rowEnd]
+            : static_cast<ElementIndex>(object.GetPoints().GetBufferElementCount()); // Last stripe also takes care of padding points
+
+        ElementCount const haloPointCount = (t < parallelism - 1)
+            ? rowStartPointIndices[rowEnd + 1] - rowStartPointIndices[rowEnd]
+            : 0;
+
+        mThreadStates.emplace_back(rowStart, rowEnd, stripePointStart, stripePointEnd, haloPointCount);
+
+        mParallelRegionTasks.emplace_back(
+            [this, t]()
+            {
+                assert(mCurrentObject != nullptr);
+
+                RunParallelRegion(
+                    *mCurrentObject,
+                    t);
+            });
+
+        rowStart = rowEnd;
+    }
+
+    mPhaseBarrier.Reset(parallelism);
+
+    LogMessage("FSBySpringStructuralIntrinsicsMTStripedSimulator: numSprings=", object.GetSprings().GetElementCount(), " numRows=", numberOfRows,
+        " numThreads=", parallelism);
+}
+
+void FSBySpringStructuralIntrinsicsMTStripedSimulator::RunParallelRegion(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState & threadState = mThreadStates[threadIndex];
+
+    // Our buffer, starting at StartPointIndex
+    vec2f * restrict const pointSpringForceBuffer = threadState.PointSpringForceBuffer.data();
+
+    for (size_t i = 0; i < mNumMechanicalDynamicsIterations; ++i)
+    {
+        // Apply spring forces
+        for (size_t r = threadState.StartRow; r < threadState.EndRow; ++r)
+        {
+            FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
+                object,
+                pointSpringForceBuffer,
+                mRows[r].StartSpringIndex,
+                mRows[r].EndSpringIndexPerfectSquare,
+                mRows[r].EndSpringIndex,
+                threadState.StartPointIndex);
+        }
+
+        // Wait for all forces to be in
+        mPhaseBarrier.ArriveAndWait();
+
+        // Integrate spring and external forces,
+        // and reset spring forces
+        IntegrateAndResetSpringForcesStripe(
+            object,
+            threadIndex);
+
+        // Wait for all positions to be in, unless this is the last iteration,
+        // in which case the end of the batch does it for us
+        if (i < mNumMechanicalDynamicsIterations - 1)
+        {
+            mPhaseBarrier.ArriveAndWait();
+        }
+    }
+}
+
+void FSBySpringStructuralIntrinsicsMTStripedSimulator::IntegrateAndResetSpringForcesStripe(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState & threadState = mThreadStates[threadIndex];
+
+    //
+    // Reduce previous stripe's halo into our forces; we're the only ones
+    // touching that halo now, so we also reset it
+    //
+
+    float * const restrict springForceBuffer = reinterpret_cast<float *>(threadState.PointSpringForceBuffer.data());
+
+    if (threadIndex > 0)
+    {
+        ThreadState & previousThreadState = mThreadStates[threadIndex - 1];
+        assert(previousThreadState.EndPointIndex == threadState.StartPointIndex);
+
+        float * const restrict haloBuffer = reinterpret_cast<float *>(
+            previousThreadState.PointSpringForceBuffer.data() + (previousThreadState.EndPointIndex - previousThreadState.StartPointIndex));
+
+        size_t const haloCount = previousThreadState.HaloPointCount * 2; // Two components per vector
+        for (size_t i = 0; i < haloCount; ++i)
+        {
+            springForceBuffer[i] += haloBuffer[i];
+            haloBuffer[i] = 0.0f;
+        }
+    }
+
+    //
+    // Integrate our points
+    //
+
+    float * const restrict positionBuffer = reinterpret_cast<float *>(object.GetPoints().GetPositionBuffer() + threadState.StartPointIndex);
+    float * const restrict velocityBuffer = reinterpret_cast<float *>(object.GetPoints().GetVelocityBuffer() + threadState.StartPointIndex);
+    float const * const restrict externalForceBuffer = reinterpret_cast<float *>(mPointExternalForceBuffer.data() + threadState.StartPointIndex);
+    float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data() + threadState.StartPointIndex);
+
+    float const dt = mDt;
+    float const velocityFactor = mVelocityFactor;
+
+    size_t const count = (threadState.EndPointIndex - threadState.StartPointIndex) * 2; // Two components per vector
+    for (size_t i = 0; i < count; ++i)
+    {
+        //
+        // Verlet integration (fourth order, with velocity being first order)
+        //
+
+        float const deltaPos =
+            velocityBuffer[i] * dt
+            + (springForceBuffer[i] + externalForceBuffer[i]) * integrationFactorBuffer[i];
+
+        positionBuffer[i] += deltaPos;
+        velocityBuffer[i] = deltaPos * velocityFactor;
+
+        // Zero out spring force now that we've integrated it
+        springForceBuffer[i] = 0.0f;
+    }
+}
+
+/////////////////////////////////////////////////
+
+ILayoutOptimizer::LayoutRemap FSBySpringStructuralIntrinsicsStripingLayoutOptimizer::Remap(
+    ObjectBuildPointIndexMatrix const & pointMatrix,
+    std::vector<ObjectBuildPoint> const & points,
+    std::vector<ObjectBuildSpring> const & springs) const
+{
+    //
+    // 1. Start from the structural layout, which gives us perfect squares and endpoint flips
+    //
+
+    LayoutRemap structuralRemap = FSBySpringStructuralIntrinsicsLayoutOptimizer().Remap(pointMatrix, points, springs);
+
+    IndexRemap const & structuralSpringRemap = structuralRemap.SpringRemap;
+
+    assert(structuralRemap.SimulatorSpecificStructure.SpringProcessingBlockSizes.size() == 1);
+    ElementCount const perfectSquareCount = structuralRemap.SimulatorSpecificStructure.SpringProcessingBlockSizes[0];
+
+    //
+    // 2. Lay out points row by row
+    //
+
+    IndexRemap optimalPointRemap(points.size());
+    ObjectSimulatorSpecificStructure simulatorSpecificStructure;
+
+    std::vector<int> pointRows(points.size(), -1);
+
+    for (int y = 0; y < pointMatrix.height; ++y)
+    {
+        ElementCount rowPointCount = 0;
+
+        for (int x = 0; x < pointMatrix.width; ++x)
+        {
+            if (pointMatrix[{x, y}])
+            {
+                ElementIndex const p = *pointMatrix[{x, y}];
+
+                optimalPointRemap.AddOld(p);
+                pointRows[p] = y;
+                ++rowPointCount;
+            }
+        }
+
+        simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(rowPointCount);
+    }
+
+    assert(std::none_of(pointRows.cbegin(), pointRows.cend(), [](int r) { return r < 0; }));
+
+    //
+    // 3. Assign perfect squares and leftover springs to the lowest row of their endpoints;
+    //    elements are referred to via their index in the structural layout
+    //
+
+    auto const getSpringRow = [&](ElementIndex s) -> int
+    {
+        ObjectBuildSpring const & spring = springs[structuralSpringRemap.NewToOld(s)];
+
+        assert(std::abs(pointRows[spring.PointAIndex] - pointRows[spring.PointBIndex]) <= 1);
+        return std::min(pointRows[spring.PointAIndex], pointRows[spring.PointBIndex]);
+    };
+
+    std::vector<std::vector<ElementIndex>> rowPerfectSquares(pointMatrix.height);
+    std::vector<std::vector<ElementIndex>> rowLeftoverSprings(pointMatrix.height);
+
+    for (ElementIndex sq = 0; sq < perfectSquareCount; ++sq)
+    {
+        // The cross springs of a perfect square span its two rows
+        rowPerfectSquares[getSpringRow(sq * 4)].push_back(sq * 4);
+    }
+
+    for (ElementIndex s = perfectSquareCount * 4; s < springs.size(); ++s)
+    {
+        rowLeftoverSprings[getSpringRow(s)].push_back(s);
+    }
+
+    //
+    // 4. Lay out springs row by row
+    //
+
+    IndexRemap optimalSpringRemap(springs.size());
+
+    for (int y = 0; y < pointMatrix.height; ++y)
+    {
+        for (ElementIndex s : rowPerfectSquares[y])
+        {
+            for (ElementIndex i = 0; i < 4; ++i)
+            {
+                optimalSpringRemap.AddOld(structuralSpringRemap.NewToOld(s + i));
+            }
+        }
+
+        for (ElementIndex s : rowLeftoverSprings[y])
+        {
+            optimalSpringRemap.AddOld(structuralSpringRemap.NewToOld(s));
+        }
+
+        simulatorSpecificStructure.SpringProcessingBlockSizes.emplace_back(static_cast<ElementCount>(rowPerfectSquares[y].size()));
+        simulatorSpecificStructure.SpringProcessingBlockSizes.emplace_back(static_cast<ElementCount>(rowLeftoverSprings[y].size()));
+    }
+
+    LogMessage("StripingLayoutOptimizer: ", pointMatrix.height, " rows");
+
+    // Endpoint flips stay as in the structural layout
+    return LayoutRemap(
+        std::move(optimalPointRemap),
+        std::move(optimalSpringRemap),
+        std::move(structuralRemap.SpringEndpointFlipMask),
+        std::move(simulatorSpecificStructure));
+}
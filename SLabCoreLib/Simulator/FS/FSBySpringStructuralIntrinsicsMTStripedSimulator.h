@@ -0,0 +1,146 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsSimulator.h"
+
+#include "Buffer.h"
+#include "Simulator/Common/ISimulator.h"
+#include "ThreadBarrier.h"
+#include "Vectors.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as in the "By Spring" - "Structural Intrinsics" simulator,
+ * with multiple threads each owning a horizontal stripe of the
+ * object.
+ *
+ * Each thread accumulates spring forces in a buffer covering only
+ * its own points plus the first row of points of the next stripe
+ * (the "halo"); at integration time, only halo points need to be
+ * reduced.
+ */
+
+class FSBySpringStructuralIntrinsicsStripingLayoutOptimizer;
+
+class FSBySpringStructuralIntrinsicsMTStripedSimulator : public FSBySpringStructuralIntrinsicsSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 18 - By Spring - Structural Instrinsics - MT - Striped";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsStripingLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsMTStripedSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void RunParallelRegion(
+        Object & object,
+        size_t threadIndex);
+
+    void IntegrateAndResetSpringForcesStripe(
+        Object & object,
+        size_t threadIndex);
+
+private:
+
+    struct RowInfo
+    {
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndexPerfectSquare; // Excluded
+        ElementIndex EndSpringIndex; // Excluded
+
+        RowInfo(
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndexPerfectSquare,
+            ElementIndex endSpringIndex)
+            : StartSpringIndex(startSpringIndex)
+            , EndSpringIndexPerfectSquare(endSpringIndexPerfectSquare)
+            , EndSpringIndex(endSpringIndex)
+        {}
+    };
+
+    struct ThreadState
+    {
+        size_t StartRow;
+        size_t EndRow; // Excluded
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+        ElementCount HaloPointCount; // Points after EndPointIndex that this thread's springs touch
+
+        // Covers [StartPointIndex, EndPointIndex + HaloPointCount)
+        Buffer<vec2f> PointSpringForceBuffer;
+
+        ThreadState(
+            size_t startRow,
+            size_t endRow,
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex,
+            ElementCount haloPointCount)
+            : StartRow(startRow)
+            , EndRow(endRow)
+            , StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+            , HaloPointCount(haloPointCount)
+            , PointSpringForceBuffer(endPointIndex - startPointIndex + haloPointCount, 0, vec2f::zero())
+        {}
+    };
+
+    std::vector<RowInfo> mRows;
+    std::vector<ThreadState> mThreadStates;
+    std::vector<typename ThreadPool::Task> mParallelRegionTasks;
+    ThreadBarrier mPhaseBarrier;
+
+    // Current update's object and parameters
+    Object * mCurrentObject;
+    size_t mNumMechanicalDynamicsIterations;
+    float mDt;
+    float mVelocityFactor;
+};
+
+/*
+ * Lays out points row by row, and springs by the lowest row of their endpoints;
+ * within each row, springs are laid out as the "Structural Intrinsics" layout
+ * optimizer does, i.e. perfect squares first.
+ *
+ * Simulator-specific structure:
+ *  - Points: the number of points of each row;
+ *  - Springs: for each row, the number of perfect squares followed by the
+ *    number of leftover springs.
+ */
+class FSBySpringStructuralIntrinsicsStripingLayoutOptimizer : public ILayoutOptimizer
+{
+public:
+
+    LayoutRemap Remap(
+        ObjectBuildPointIndexMatrix const & pointMatrix,
+        std::vector<ObjectBuildPoint> const & points,
+        std::vector<ObjectBuildSpring> const & springs) const override;
+};
@@ -26,6 +26,19 @@ FSBySpringStructuralIntrinsicsSimulator::FSBySpringStructuralIntrinsicsSimulator
     Object const & object,
     SimulationParameters const & simulationParameters,
     ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsSimulator(
+        object,
+        simulationParameters,
+        threadManager,
+        GetSpringPerfectSquareCount(object))
+{
+}
+
+FSBySpringStructuralIntrinsicsSimulator::FSBySpringStructuralIntrinsicsSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager,
+    ElementCount springPerfectSquareCount)
     // Point buffers
     : mPointSpringForceBuffer(object.GetPoints().GetBufferElementCount(), 0, vec2f::zero())
     , mPointExternalForceBuffer(object.GetPoints().GetBufferElementCount(), 0, vec2f::zero())
@@ -33,11 +46,10 @@ FSBySpringStructuralIntrinsicsSimulator::FSBySpringStructuralIntrinsicsSimulator
     // Spring buffers
     , mSpringStiffnessCoefficientBuffer(object.GetSprings().GetBufferElementCount(), 0, 0.0f)
     , mSpringDampingCoefficientBuffer(object.GetSprings().GetBufferElementCount(), 0, 0.0f)
+    // Structure
+    , mSpringPerfectSquareCount(springPerfectSquareCount)
 {
     CreateState(object, simulationParameters, threadManager);
-
-    assert(object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes.size() == 1);
-    mSpringPerfectSquareCount = object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes[0];
 }
 
 void FSBySpringStructuralIntrinsicsSimulator::OnStateChanged(
@@ -67,6 +79,13 @@ void FSBySpringStructuralIntrinsicsSimulator::Update(
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 
+ElementCount FSBySpringStructuralIntrinsicsSimulator::GetSpringPerfectSquareCount(Object const & object)
+{
+    // Our layout has one block only - the perfect squares at the beginning of the springs
+    assert(object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes.size() == 1);
+    return object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes[0];
+}
+
 void FSBySpringStructuralIntrinsicsSimulator::CreateState(
     Object const & object,
     SimulationParameters const & simulationParameters,
@@ -148,6 +167,22 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
     vec2f * restrict pointSpringForceBuffer,
     ElementIndex startSpringIndex,
     ElementCount endSpringIndex)  // Excluded
+{
+    ApplySpringsForcesVectorized(
+        object,
+        pointSpringForceBuffer,
+        startSpringIndex,
+        std::min(endSpringIndex, mSpringPerfectSquareCount * 4),
+        endSpringIndex);
+}
+
+void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
+    Object const & object,
+    vec2f * restrict pointSpringForceBuffer,
+    ElementIndex startSpringIndex,
+    ElementCount endSpringIndexPerfectSquare, // Excluded
+    ElementCount endSpringIndex,  // Excluded
+    ElementIndex forceBufferStartPointIndex)
 {
     // This implementation is for 4-float SSE
 #if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
@@ -172,8 +207,11 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
     // 1. Perfect squares
     //
 
-    ElementCount const endSpringIndexPerfectSquare = std::min(endSpringIndex, mSpringPerfectSquareCount * 4);
-    
+    assert(endSpringIndexPerfectSquare <= endSpringIndex);
+    assert(((endSpringIndexPerfectSquare - startSpringIndex) % 4) == 0 || startSpringIndex >= endSpringIndexPerfectSquare);
+
+    // Note: spring ranges need not start at a vectorization boundary, hence the unaligned loads
+
     for (; s < endSpringIndexPerfectSquare; s += 4)
     {
         // XMM register notation:
@@ -295,8 +333,8 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
             _mm_mul_ps(
                 _mm_sub_ps(
                     s0s1s2s3_springLength, 
-                    _mm_load_ps(restLengthBuffer + s)),
-                _mm_load_ps(stiffnessCoefficientBuffer + s));
+                    _mm_loadu_ps(restLengthBuffer + s)),
+                _mm_loadu_ps(stiffnessCoefficientBuffer + s));
 
         //
         // 2. Damper forces
@@ -336,7 +374,7 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
                 _mm_add_ps( // Dot product
                     _mm_mul_ps(s0s1s2s3_rvel_x, s0s1s2s3_sdir_x),
                     _mm_mul_ps(s0s1s2s3_rvel_y, s0s1s2s3_sdir_y)),
-                _mm_load_ps(dampingCoefficientBuffer + s));
+                _mm_loadu_ps(dampingCoefficientBuffer + s));
 
         //
         // 3. Apply forces: 
@@ -390,17 +428,17 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
         _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), jm_sforce_xy);
         _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[2])), lk_sforce_xy);
 
-        pointSpringForceBuffer[pointJIndex] += tmpSpringForces[0];
-        pointSpringForceBuffer[pointMIndex] += tmpSpringForces[1];
-        pointSpringForceBuffer[pointLIndex] -= tmpSpringForces[2];
-        pointSpringForceBuffer[pointKIndex] -= tmpSpringForces[3];
+        pointSpringForceBuffer[pointJIndex - forceBufferStartPointIndex] += tmpSpringForces[0];
+        pointSpringForceBuffer[pointMIndex - forceBufferStartPointIndex] += tmpSpringForces[1];
+        pointSpringForceBuffer[pointLIndex - forceBufferStartPointIndex] -= tmpSpringForces[2];
+        pointSpringForceBuffer[pointKIndex - forceBufferStartPointIndex] -= tmpSpringForces[3];
     }
 
     //
     // 2. Remaining four-by-four's
     //
 
-    ElementCount const endSpringIndexVectorized = endSpringIndex - (endSpringIndex % 4);
+    ElementCount const endSpringIndexVectorized = s + (endSpringIndex - s) / 4 * 4;
 
     for (; s < endSpringIndexVectorized; s += 4)
     {
@@ -483,8 +521,8 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
         // ( springLength[s3] - restLength[s3] ) * stiffness[s3]
         //
 
-        __m128 const s0s1s2s3_restLength = _mm_load_ps(restLengthBuffer + s);
-        __m128 const s0s1s2s3_stiffness = _mm_load_ps(stiffnessCoefficientBuffer + s);
+        __m128 const s0s1s2s3_restLength = _mm_loadu_ps(restLengthBuffer + s);
+        __m128 const s0s1s2s3_stiffness = _mm_loadu_ps(stiffnessCoefficientBuffer + s);
 
         __m128 const s0s1s2s3_hooke_forceModuli = _mm_mul_ps(
             _mm_sub_ps(s0s1s2s3_springLength, s0s1s2s3_restLength),
@@ -542,7 +580,7 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
         __m128 s0s1s2s3_relvel_y = _mm_shuffle_ps(s0s1_relvel_xy, s2s3_relvel_xy, 0xDD);
 
         // Damping coeffs
-        __m128 const s0s1s2s3_dampingCoeff = _mm_load_ps(dampingCoefficientBuffer + s);
+        __m128 const s0s1s2s3_dampingCoeff = _mm_loadu_ps(dampingCoefficientBuffer + s);
 
         __m128 const s0s1s2s3_damping_forceModuli =
             _mm_mul_ps(
@@ -593,14 +631,14 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
         _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[0])), s0s1_tforceA_xy);
         _mm_store_ps(reinterpret_cast<float *>(&(tmpSpringForces[2])), s2s3_tforceA_xy);
 
-        pointSpringForceBuffer[endpointsBuffer[s + 0].PointAIndex] += tmpSpringForces[0];
-        pointSpringForceBuffer[endpointsBuffer[s + 0].PointBIndex] -= tmpSpringForces[0];
-        pointSpringForceBuffer[endpointsBuffer[s + 1].PointAIndex] += tmpSpringForces[1];
-        pointSpringForceBuffer[endpointsBuffer[s + 1].PointBIndex] -= tmpSpringForces[1];
-        pointSpringForceBuffer[endpointsBuffer[s + 2].PointAIndex] += tmpSpringForces[2];
-        pointSpringForceBuffer[endpointsBuffer[s + 2].PointBIndex] -= tmpSpringForces[2];
-        pointSpringForceBuffer[endpointsBuffer[s + 3].PointAIndex] += tmpSpringForces[3];
-        pointSpringForceBuffer[endpointsBuffer[s + 3].PointBIndex] -= tmpSpringForces[3];
+        pointSpringForceBuffer[endpointsBuffer[s + 0].PointAIndex - forceBufferStartPointIndex] += tmpSpringForces[0];
+        pointSpringForceBuffer[endpointsBuffer[s + 0].PointBIndex - forceBufferStartPointIndex] -= tmpSpringForces[0];
+        pointSpringForceBuffer[endpointsBuffer[s + 1].PointAIndex - forceBufferStartPointIndex] += tmpSpringForces[1];
+        pointSpringForceBuffer[endpointsBuffer[s + 1].PointBIndex - forceBufferStartPointIndex] -= tmpSpringForces[1];
+        pointSpringForceBuffer[endpointsBuffer[s + 2].PointAIndex - forceBufferStartPointIndex] += tmpSpringForces[2];
+        pointSpringForceBuffer[endpointsBuffer[s + 2].PointBIndex - forceBufferStartPointIndex] -= tmpSpringForces[2];
+        pointSpringForceBuffer[endpointsBuffer[s + 3].PointAIndex - forceBufferStartPointIndex] += tmpSpringForces[3];
+        pointSpringForceBuffer[endpointsBuffer[s + 3].PointBIndex - forceBufferStartPointIndex] -= tmpSpringForces[3];
     }
 
     //
@@ -643,8 +681,8 @@ void FSBySpringStructuralIntrinsicsSimulator::ApplySpringsForcesVectorized(
         //
 
         vec2f const forceA = springDir * (fSpring + fDamp);
-        pointSpringForceBuffer[pointAIndex] += forceA;
-        pointSpringForceBuffer[pointBIndex] -= forceA;
+        pointSpringForceBuffer[pointAIndex - forceBufferStartPointIndex] += forceA;
+        pointSpringForceBuffer[pointBIndex - forceBufferStartPointIndex] -= forceA;
     }
 }
 
@@ -56,6 +56,17 @@ public:
 
 protected:
 
+    /*
+     * For derived simulators whose layouts differ from ours: springPerfectSquareCount
+     * is the number of perfect squares at the beginning of the springs, which is what
+     * ApplySpringsForcesVectorized() relaxes as such unless told otherwise.
+     */
+    FSBySpringStructuralIntrinsicsSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager,
+        ElementCount springPerfectSquareCount);
+
     virtual void CreateState(
         Object const & object,
         SimulationParameters const & simulationParameters,
@@ -71,6 +82,16 @@ protected:
         ElementIndex startSpringIndex,
         ElementCount endSpringIndex);  // Excluded
 
+    // Perfect squares are in [startSpringIndex, endSpringIndexPerfectSquare);
+    // pointSpringForceBuffer starts at point forceBufferStartPointIndex
+    void ApplySpringsForcesVectorized(
+        Object const & object,
+        vec2f * restrict pointSpringForceBuffer,
+        ElementIndex startSpringIndex,
+        ElementCount endSpringIndexPerfectSquare, // Excluded
+        ElementCount endSpringIndex,  // Excluded
+        ElementIndex forceBufferStartPointIndex = 0);
+
     virtual void IntegrateAndResetSpringForces(
         Object & object,
         SimulationParameters const & simulationParameters);
@@ -95,6 +116,10 @@ protected:
 
     // Structure
     ElementCount mSpringPerfectSquareCount;
+
+private:
+
+    static ElementCount GetSpringPerfectSquareCount(Object const & object);
 };
 
 class FSBySpringStructuralIntrinsicsLayoutOptimizer : public ILayoutOptimizer
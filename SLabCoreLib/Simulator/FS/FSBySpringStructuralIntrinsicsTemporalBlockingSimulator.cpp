@@ -0,0 +1,129 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSBySpringStructuralIntrinsicsTemporalBlockingSimulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+/*
+ * In the "Fused" simulator, row r may be updated for iteration i as soon as:
+ *  - row r-1 has been updated for iteration i, as its springs contribute to the forces of row r; and
+ *  - row r+1 has been updated for iteration i-1 - but not yet for iteration i - as the springs
+ *    of row r read its positions and velocities, and contribute to its forces.
+ *
+ * Hence we may advance a tile of rows through multiple iterations at once, as long
+ * as each iteration of the tile lags one row behind the previous iteration; i.e. tiles
+ * are parallelograms in the (row, iteration) space:
+ *
+ *  iteration
+ *      ^
+ *      |     /////////
+ *      |    /////////
+ *      |   /////////
+ *      |  /////////
+ *      +-------------------> row
+ *
+ * The first tile is clipped at row zero, and the last tile is extended to the last row.
+ *
+ * Since each row is updated exactly as in the "Fused" simulator - in the same order
+ * with respect to its neighbors - results are identical, but a tile's rows stay in
+ * the cache for all of its iterations.
+ */
+
+FSBySpringStructuralIntrinsicsTemporalBlockingSimulator::FSBySpringStructuralIntrinsicsTemporalBlockingSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : FSBySpringStructuralIntrinsicsFusedSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mTileIterations(0)
+    , mTileRowCount(0)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FSBySpringStructuralIntrinsicsTemporalBlockingSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & /*threadManager*/)
+{
+    size_t const numMechanicalDynamicsIterations = simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations;
+
+    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(numMechanicalDynamicsIterations);
+
+    float const globalDamping =
+        1.0f -
+        pow((1.0f - simulationParameters.FSCommonSimulator.GlobalDamping),
+            12.0f / static_cast<float>(numMechanicalDynamicsIterations));
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    float const velocityFactor = (1.0f - globalDamping) / dt;
+
+    // Rows are signed here, as skewed tiles start before row zero
+    int const numberOfRows = static_cast<int>(mRows.size());
+    int const tileRowCount = static_cast<int>(mTileRowCount);
+
+    for (size_t i = 0; i < numMechanicalDynamicsIterations; i += mTileIterations)
+    {
+        int const tileIterations = static_cast<int>(std::min(mTileIterations, numMechanicalDynamicsIterations - i));
+
+        for (int tileStartRow = 0; tileStartRow < numberOfRows; tileStartRow += tileRowCount)
+        {
+            bool const isLastTile = (tileStartRow + tileRowCount >= numberOfRows);
+
+            for (int ti = 0; ti < tileIterations; ++ti)
+            {
+                // Each iteration lags one row behind the previous one
+                int const startRow = std::max(tileStartRow - ti, 0);
+                int const endRow = isLastTile
+                    ? numberOfRows
+                    : tileStartRow + tileRowCount - ti;
+
+                for (int r = startRow; r < endRow; ++r)
+                {
+                    UpdateRow(object, static_cast<size_t>(r), dt, velocityFactor);
+                }
+            }
+        }
+    }
+}
+
+void FSBySpringStructuralIntrinsicsTemporalBlockingSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    FSBySpringStructuralIntrinsicsFusedSimulator::CreateState(object, simulationParameters, threadManager);
+
+    //
+    // Calculate tile size, based on the average number of bytes touched by a row:
+    // position, velocity, spring force, external force, and integration factor for
+    // each point, and endpoints, rest length, stiffness, and damping for each spring
+    //
+
+    size_t const numberOfRows = std::max(mRows.size(), size_t(1));
+
+    size_t const pointBytes = object.GetPoints().GetElementCount() * sizeof(vec2f) * 5;
+    size_t const springBytes = object.GetSprings().GetElementCount() * (sizeof(Springs::Endpoints) + sizeof(float) * 3);
+    size_t const averageRowByteSize = std::max((pointBytes + springBytes) / numberOfRows, size_t(1));
+
+    size_t const tileRowCapacity = std::max(TargetTileByteSize / averageRowByteSize, size_t(2));
+
+    // A tile spans its rows plus the skew, i.e. one row per iteration; we split the capacity evenly
+    mTileIterations = std::clamp(tileRowCapacity / 2, size_t(1), MaxTileIterations);
+    mTileRowCount = tileRowCapacity - mTileIterations;
+
+    LogMessage("FSBySpringStructuralIntrinsicsTemporalBlockingSimulator: averageRowByteSize=", averageRowByteSize,
+        " tileRowCount=", mTileRowCount, " tileIterations=", mTileIterations);
+}
@@ -0,0 +1,63 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FSBySpringStructuralIntrinsicsFusedSimulator.h"
+
+#include "Simulator/Common/ISimulator.h"
+
+#include <memory>
+#include <string>
+
+/*
+ * Simulator implementing the same algorithm as the "Fused" simulator,
+ * advancing cache-sized tiles of rows through multiple mechanical
+ * dynamics iterations at once, rather than sweeping the whole object
+ * once per iteration.
+ */
+
+class FSBySpringStructuralIntrinsicsTemporalBlockingSimulator : public FSBySpringStructuralIntrinsicsFusedSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 31 - By Spring - Structural Instrinsics - Temporal Blocking";
+    }
+
+    using layout_optimizer = FSBySpringStructuralIntrinsicsStripingLayoutOptimizer;
+
+public:
+
+    FSBySpringStructuralIntrinsicsTemporalBlockingSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    virtual void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+private:
+
+    // The number of bytes we want a tile - including its skew - to occupy
+    static size_t constexpr TargetTileByteSize = 192 * 1024;
+
+    // The max number of iterations a tile is advanced by at once
+    static size_t constexpr MaxTileIterations = 16;
+
+    size_t mTileIterations;
+    size_t mTileRowCount;
+};
@@ -0,0 +1,499 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FSGridSimulator.h"
+
+#include "Log.h"
+#include "SysSpecifics.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+/*
+ * The grid has the same rows and columns as the build point matrix, which has one
+ * row and one column of empty cells on each side; hence, no spring ever leaves
+ * the grid, and the stencil may run on whole rows without special cases at the
+ * boundaries.
+ *
+ * Cells are processed four at a time, row by row; for each spring direction, the
+ * four "other" endpoints are contiguous, at a fixed offset from the block:
+ *
+ *      E:  +1
+ *      SE: -gridWidth + 1
+ *      S:  -gridWidth
+ *      SW: -gridWidth - 1
+ *
+ * At each update we gather points' positions and velocities into the grid, run all
+ * mechanical dynamics iterations on the grid, and then scatter them back.
+ */
+
+FSGridSimulator::FSGridSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & /*threadManager*/)
+    // Grid
+    : mGridWidth(make_aligned_float_element_count(static_cast<int>(object.GetSimulatorSpecificStructure().PointProcessingBlockSizes[0])))
+    , mGridHeight(static_cast<int>(object.GetSimulatorSpecificStructure().PointProcessingBlockSizes[1]))
+    , mCellCount(static_cast<size_t>(mGridWidth) * static_cast<size_t>(mGridHeight))
+    , mPointCellIndices()
+    // Cell buffers
+    , mCellPositionXBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellPositionYBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellVelocityXBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellVelocityYBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellSpringForceXBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellSpringForceYBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellExternalForceXBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellExternalForceYBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    , mCellIntegrationFactorBuffer(CellBufferPadding + mCellCount + CellBufferPadding, 0, 0.0f)
+    // Spring buffers
+    , mSpringCoefficientBuffer(mCellCount / 4 * SpringCoefficientBlockSize, 0, 0.0f)
+{
+    //
+    // Decode the cell of each point
+    //
+
+    auto const & pointBlockSizes = object.GetSimulatorSpecificStructure().PointProcessingBlockSizes;
+
+    mPointCellIndices.reserve(object.GetPoints().GetElementCount());
+
+    size_t i = 2;
+    for (int y = 0; y < mGridHeight; ++y)
+    {
+        assert(i < pointBlockSizes.size());
+        ElementCount const runCount = pointBlockSizes[i++];
+
+        for (ElementCount r = 0; r < runCount; ++r)
+        {
+            ElementCount const runStartX = pointBlockSizes[i++];
+            ElementCount const runLength = pointBlockSizes[i++];
+
+            for (ElementCount x = runStartX; x < runStartX + runLength; ++x)
+            {
+                mPointCellIndices.emplace_back(static_cast<ElementIndex>(y * mGridWidth + x));
+            }
+        }
+    }
+
+    assert(i == pointBlockSizes.size());
+    assert(mPointCellIndices.size() == object.GetPoints().GetElementCount());
+
+    LogMessage("FSGridSimulator: gridWidth=", mGridWidth, " gridHeight=", mGridHeight, " points=", mPointCellIndices.size(),
+        " occupancy=", static_cast<float>(mPointCellIndices.size()) / static_cast<float>(mCellCount));
+
+    CreateState(object, simulationParameters);
+}
+
+void FSGridSimulator::OnStateChanged(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & /*threadManager*/)
+{
+    CreateState(object, simulationParameters);
+}
+
+void FSGridSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & /*threadManager*/)
+{
+    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations);
+
+    float const globalDamping =
+        1.0f -
+        pow((1.0f - simulationParameters.FSCommonSimulator.GlobalDamping),
+            12.0f / static_cast<float>(simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations));
+
+    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
+    // provides the final, damped velocity
+    float const velocityFactor = (1.0f - globalDamping) / dt;
+
+    GatherPoints(object);
+
+    for (size_t i = 0; i < simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations; ++i)
+    {
+        // Apply spring forces
+        ApplySpringsForces();
+
+        // Integrate spring and external forces,
+        // and reset spring forces
+        IntegrateAndResetSpringForces(dt, velocityFactor);
+    }
+
+    ScatterPoints(object);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+
+void FSGridSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters)
+{
+    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.FSCommonSimulator.NumMechanicalDynamicsIterations);
+    float const dtSquared = dt * dt;
+
+    //
+    // Initialize cell buffers
+    //
+
+    Points const & points = object.GetPoints();
+
+    float * restrict const externalForceXBuffer = GetCellData(mCellExternalForceXBuffer);
+    float * restrict const externalForceYBuffer = GetCellData(mCellExternalForceYBuffer);
+    float * restrict const integrationFactorBuffer = GetCellData(mCellIntegrationFactorBuffer);
+
+    for (auto pointIndex : points)
+    {
+        ElementIndex const c = mPointCellIndices[pointIndex];
+
+        vec2f const externalForce =
+            simulationParameters.Common.AssignedGravity * points.GetMass(pointIndex) * simulationParameters.Common.MassAdjustment
+            + points.GetAssignedForce(pointIndex);
+
+        externalForceXBuffer[c] = externalForce.x;
+        externalForceYBuffer[c] = externalForce.y;
+
+        integrationFactorBuffer[c] =
+            dtSquared
+            / (points.GetMass(pointIndex) * simulationParameters.Common.MassAdjustment)
+            * points.GetFrozenCoefficient(pointIndex);
+    }
+
+    //
+    // Initialize spring buffers
+    //
+
+    Springs const & springs = object.GetSprings();
+
+    for (auto springIndex : springs)
+    {
+        auto const endpointAIndex = springs.GetEndpointAIndex(springIndex);
+        auto const endpointBIndex = springs.GetEndpointBIndex(springIndex);
+
+        // Find direction and cell owning this spring
+
+        int const cellA = static_cast<int>(mPointCellIndices[endpointAIndex]);
+        int const cellB = static_cast<int>(mPointCellIndices[endpointBIndex]);
+
+        int const dx = (cellB % mGridWidth) - (cellA % mGridWidth);
+        int const dy = (cellB / mGridWidth) - (cellA / mGridWidth);
+
+        // Make it so that the spring goes from A towards E, SE, S, or SW
+        int const sign = (dy < 0 || (dy == 0 && dx > 0)) ? 1 : -1;
+
+        int const cell = (sign > 0) ? cellA : cellB;
+
+        SpringDirection direction;
+        if (dy == 0)
+        {
+            assert(std::abs(dx) == 1);
+            direction = SpringDirection::E;
+        }
+        else if (dx * sign == 1)
+        {
+            assert(dy * sign == -1);
+            direction = SpringDirection::SE;
+        }
+        else if (dx == 0)
+        {
+            assert(dy * sign == -1);
+            direction = SpringDirection::S;
+        }
+        else
+        {
+            assert(dx * sign == -1 && dy * sign == -1);
+            direction = SpringDirection::SW;
+        }
+
+        float const endpointAMass = points.GetMass(endpointAIndex) * simulationParameters.Common.MassAdjustment;
+        float const endpointBMass = points.GetMass(endpointBIndex) * simulationParameters.Common.MassAdjustment;
+
+        float const massFactor =
+            (endpointAMass * endpointBMass)
+            / (endpointAMass + endpointBMass);
+
+        float * const coefficients =
+            mSpringCoefficientBuffer.data()
+            + (cell / 4) * SpringCoefficientBlockSize
+            + direction * 3 * 4
+            + (cell % 4);
+
+        // Rest length
+        coefficients[0] = springs.GetRestLength(springIndex);
+
+        // The "stiffness coefficient" is the factor which, once multiplied with the spring displacement,
+        // yields the spring force, according to Hooke's law.
+        coefficients[4] =
+            simulationParameters.FSCommonSimulator.SpringReductionFraction
+            * springs.GetMaterialStiffness(springIndex)
+            * massFactor
+            / dtSquared;
+
+        // Damping coefficient
+        // Magnitude of the drag force on the relative velocity component along the spring.
+        coefficients[8] =
+            simulationParameters.FSCommonSimulator.SpringDampingCoefficient
+            * massFactor
+            / dt;
+    }
+}
+
+void FSGridSimulator::GatherPoints(Object const & object)
+{
+    vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f const * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+
+    float * restrict const positionXBuffer = GetCellData(mCellPositionXBuffer);
+    float * restrict const positionYBuffer = GetCellData(mCellPositionYBuffer);
+    float * restrict const velocityXBuffer = GetCellData(mCellVelocityXBuffer);
+    float * restrict const velocityYBuffer = GetCellData(mCellVelocityYBuffer);
+
+    ElementCount const pointCount = static_cast<ElementCount>(mPointCellIndices.size());
+    for (ElementIndex p = 0; p < pointCount; ++p)
+    {
+        ElementIndex const c = mPointCellIndices[p];
+
+        positionXBuffer[c] = pointPositionBuffer[p].x;
+        positionYBuffer[c] = pointPositionBuffer[p].y;
+        velocityXBuffer[c] = pointVelocityBuffer[p].x;
+        velocityYBuffer[c] = pointVelocityBuffer[p].y;
+    }
+}
+
+void FSGridSimulator::ScatterPoints(Object & object) const
+{
+    vec2f * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+
+    float const * restrict const positionXBuffer = GetCellData(mCellPositionXBuffer);
+    float const * restrict const positionYBuffer = GetCellData(mCellPositionYBuffer);
+    float const * restrict const velocityXBuffer = GetCellData(mCellVelocityXBuffer);
+    float const * restrict const velocityYBuffer = GetCellData(mCellVelocityYBuffer);
+
+    ElementCount const pointCount = static_cast<ElementCount>(mPointCellIndices.size());
+    for (ElementIndex p = 0; p < pointCount; ++p)
+    {
+        ElementIndex const c = mPointCellIndices[p];
+
+        pointPositionBuffer[p] = vec2f(positionXBuffer[c], positionYBuffer[c]);
+        pointVelocityBuffer[p] = vec2f(velocityXBuffer[c], velocityYBuffer[c]);
+    }
+}
+
+void FSGridSimulator::ApplySpringsForces()
+{
+    // This implementation is for 4-float SSE
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    float const * restrict const positionXBuffer = GetCellData(mCellPositionXBuffer);
+    float const * restrict const positionYBuffer = GetCellData(mCellPositionYBuffer);
+    float const * restrict const velocityXBuffer = GetCellData(mCellVelocityXBuffer);
+    float const * restrict const velocityYBuffer = GetCellData(mCellVelocityYBuffer);
+    float * restrict const springForceXBuffer = GetCellData(mCellSpringForceXBuffer);
+    float * restrict const springForceYBuffer = GetCellData(mCellSpringForceYBuffer);
+    float const * restrict const springCoefficientBuffer = mSpringCoefficientBuffer.data();
+
+    std::ptrdiff_t const gridWidth = static_cast<std::ptrdiff_t>(mGridWidth);
+
+    std::ptrdiff_t const NeighborOffsets[SpringDirection::_Count] = {
+        1,              // E
+        -gridWidth + 1, // SE
+        -gridWidth,     // S
+        -gridWidth - 1  // SW
+    };
+
+    __m128 const Zero = _mm_setzero_ps();
+
+    // First and last rows are empty
+    for (std::ptrdiff_t y = 1; y < mGridHeight - 1; ++y)
+    {
+        for (std::ptrdiff_t c = y * gridWidth; c < (y + 1) * gridWidth; c += 4)
+        {
+            float const * restrict const coefficients = springCoefficientBuffer + (c / 4) * SpringCoefficientBlockSize;
+
+            __m128 const c_pos_x = _mm_load_ps(positionXBuffer + c);
+            __m128 const c_pos_y = _mm_load_ps(positionYBuffer + c);
+            __m128 const c_vel_x = _mm_load_ps(velocityXBuffer + c);
+            __m128 const c_vel_y = _mm_load_ps(velocityYBuffer + c);
+
+            __m128 c_sforce_x = Zero;
+            __m128 c_sforce_y = Zero;
+
+            for (size_t d = 0; d < SpringDirection::_Count; ++d)
+            {
+                std::ptrdiff_t const n = c + NeighborOffsets[d];
+                assert(static_cast<std::ptrdiff_t>(CellBufferPadding) + n >= 0); // At worst, in the leading padding
+
+                //
+                // Calculate displacements, string lengths, and spring directions
+                //
+
+                __m128 const dis_x = _mm_sub_ps(_mm_loadu_ps(positionXBuffer + n), c_pos_x);
+                __m128 const dis_y = _mm_sub_ps(_mm_loadu_ps(positionYBuffer + n), c_pos_y);
+
+                __m128 const sq_len =
+                    _mm_add_ps(
+                        _mm_mul_ps(dis_x, dis_x),
+                        _mm_mul_ps(dis_y, dis_y));
+
+                __m128 const validMask = _mm_cmpneq_ps(sq_len, Zero); // SL==0 => 1/SL==0, to maintain "normalized == (0, 0)", as in vec2f
+
+                __m128 const springLength_inv =
+                    _mm_and_ps(
+                        _mm_rsqrt_ps(sq_len),
+                        validMask);
+
+                __m128 const springLength =
+                    _mm_and_ps(
+                        _mm_rcp_ps(springLength_inv),
+                        validMask);
+
+                __m128 const sdir_x = _mm_mul_ps(dis_x, springLength_inv);
+                __m128 const sdir_y = _mm_mul_ps(dis_y, springLength_inv);
+
+                //
+                // 1. Hooke's law; springs that do not exist have zero rest length and zero stiffness
+                //
+
+                __m128 const hooke_forceModuli =
+                    _mm_mul_ps(
+                        _mm_sub_ps(
+                            springLength,
+                            _mm_load_ps(coefficients + d * 12 + 0)),
+                        _mm_load_ps(coefficients + d * 12 + 4));
+
+                //
+                // 2. Damper forces; springs that do not exist have zero damping
+                //
+
+                __m128 const rvel_x = _mm_sub_ps(_mm_loadu_ps(velocityXBuffer + n), c_vel_x);
+                __m128 const rvel_y = _mm_sub_ps(_mm_loadu_ps(velocityYBuffer + n), c_vel_y);
+
+                __m128 const damping_forceModuli =
+                    _mm_mul_ps(
+                        _mm_add_ps( // Dot product
+                            _mm_mul_ps(rvel_x, sdir_x),
+                            _mm_mul_ps(rvel_y, sdir_y)),
+                        _mm_load_ps(coefficients + d * 12 + 8));
+
+                //
+                // 3. Apply forces:
+                //      force C = springDir * (hookeForce + dampingForce)
+                //      force N = - forceC
+                //
+
+                __m128 const tForceModuli = _mm_add_ps(hooke_forceModuli, damping_forceModuli);
+
+                __m128 const tforceC_x = _mm_mul_ps(sdir_x, tForceModuli);
+                __m128 const tforceC_y = _mm_mul_ps(sdir_y, tForceModuli);
+
+                c_sforce_x = _mm_add_ps(c_sforce_x, tforceC_x);
+                c_sforce_y = _mm_add_ps(c_sforce_y, tforceC_y);
+
+                _mm_storeu_ps(springForceXBuffer + n, _mm_sub_ps(_mm_loadu_ps(springForceXBuffer + n), tforceC_x));
+                _mm_storeu_ps(springForceYBuffer + n, _mm_sub_ps(_mm_loadu_ps(springForceYBuffer + n), tforceC_y));
+            }
+
+            // Note: must come after the E neighbors', as they overlap with ours
+            _mm_store_ps(springForceXBuffer + c, _mm_add_ps(_mm_load_ps(springForceXBuffer + c), c_sforce_x));
+            _mm_store_ps(springForceYBuffer + c, _mm_add_ps(_mm_load_ps(springForceYBuffer + c), c_sforce_y));
+        }
+    }
+}
+
+void FSGridSimulator::IntegrateAndResetSpringForces(
+    float dt,
+    float velocityFactor)
+{
+    float * const restrict positionXBuffer = GetCellData(mCellPositionXBuffer);
+    float * const restrict positionYBuffer = GetCellData(mCellPositionYBuffer);
+    float * const restrict velocityXBuffer = GetCellData(mCellVelocityXBuffer);
+    float * const restrict velocityYBuffer = GetCellData(mCellVelocityYBuffer);
+    float * const restrict springForceXBuffer = GetCellData(mCellSpringForceXBuffer);
+    float * const restrict springForceYBuffer = GetCellData(mCellSpringForceYBuffer);
+    float const * const restrict externalForceXBuffer = GetCellData(mCellExternalForceXBuffer);
+    float const * const restrict externalForceYBuffer = GetCellData(mCellExternalForceYBuffer);
+    float const * const restrict integrationFactorBuffer = GetCellData(mCellIntegrationFactorBuffer);
+
+    for (size_t c = 0; c < mCellCount; ++c)
+    {
+        //
+        // Verlet integration (fourth order, with velocity being first order)
+        //
+
+        float const deltaPosX =
+            velocityXBuffer[c] * dt
+            + (springForceXBuffer[c] + externalForceXBuffer[c]) * integrationFactorBuffer[c];
+
+        float const deltaPosY =
+            velocityYBuffer[c] * dt
+            + (springForceYBuffer[c] + externalForceYBuffer[c]) * integrationFactorBuffer[c];
+
+        positionXBuffer[c] += deltaPosX;
+        positionYBuffer[c] += deltaPosY;
+        velocityXBuffer[c] = deltaPosX * velocityFactor;
+        velocityYBuffer[c] = deltaPosY * velocityFactor;
+
+        // Zero out spring force now that we've integrated it
+        springForceXBuffer[c] = 0.0f;
+        springForceYBuffer[c] = 0.0f;
+    }
+}
+
+/////////////////////////////////////////////////
+
+ILayoutOptimizer::LayoutRemap FSGridLayoutOptimizer::Remap(
+    ObjectBuildPointIndexMatrix const & pointMatrix,
+    std::vector<ObjectBuildPoint> const & points,
+    std::vector<ObjectBuildSpring> const & springs) const
+{
+    IndexRemap optimalPointRemap(points.size());
+    ObjectSimulatorSpecificStructure simulatorSpecificStructure;
+
+    simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(static_cast<ElementCount>(pointMatrix.width));
+    simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(static_cast<ElementCount>(pointMatrix.height));
+
+    for (int y = 0; y < pointMatrix.height; ++y)
+    {
+        std::vector<std::pair<ElementCount, ElementCount>> runs; // Start X, length
+
+        for (int x = 0; x < pointMatrix.width; ++x)
+        {
+            if (pointMatrix[{x, y}])
+            {
+                optimalPointRemap.AddOld(*pointMatrix[{x, y}]);
+
+                if (!runs.empty() && runs.back().first + runs.back().second == static_cast<ElementCount>(x))
+                {
+                    ++(runs.back().second);
+                }
+                else
+                {
+                    runs.emplace_back(static_cast<ElementCount>(x), 1);
+                }
+            }
+        }
+
+        simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(static_cast<ElementCount>(runs.size()));
+        for (auto const & run : runs)
+        {
+            simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(run.first);
+            simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(run.second);
+        }
+    }
+
+    // Springs are not addressed by index, hence their order does not matter
+    return LayoutRemap(
+        std::move(optimalPointRemap),
+        IndexRemap::MakeIdempotent(springs.size()),
+        std::vector<bool>(springs.size(), false),
+        std::move(simulatorSpecificStructure));
+}
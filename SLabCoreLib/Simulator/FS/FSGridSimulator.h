@@ -0,0 +1,161 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Simulator/Common/ISimulator.h"
+
+#include "Buffer.h"
+#include "ILayoutOptimizer.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Simulator implementing the same spring relaxation algorithm
+ * as Floating Sandbox 1.17.5, on a dense grid mirroring the
+ * object's pixel lattice.
+ *
+ * Springs are never addressed via their endpoints: each cell
+ * has four springs - E, SE, S, and SW - whose other endpoints are
+ * at fixed offsets in the grid, and springs whose endpoints are
+ * not both in the object have all-zero coefficients. Spring forces
+ * are thus calculated with a streaming stencil, without gathers.
+ */
+
+class FSGridLayoutOptimizer;
+
+class FSGridSimulator : public ISimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "FS 40 - Grid";
+    }
+
+    using layout_optimizer = FSGridLayoutOptimizer;
+
+public:
+
+    FSGridSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    //////////////////////////////////////////////////////////
+    // ISimulator
+    //////////////////////////////////////////////////////////
+
+    void OnStateChanged(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters);
+
+    void GatherPoints(Object const & object);
+
+    void ScatterPoints(Object & object) const;
+
+    void ApplySpringsForces();
+
+    void IntegrateAndResetSpringForces(
+        float dt,
+        float velocityFactor);
+
+private:
+
+    // The directions of the springs of each cell, in the same order as ObjectBuilder's
+    enum SpringDirection : size_t
+    {
+        E = 0,
+        SE,
+        S,
+        SW,
+
+        _Count
+    };
+
+    // Coefficients of the springs of a block of four cells: for each direction,
+    // four rest lengths, four stiffness coefficients, and four damping coefficients
+    static size_t constexpr SpringCoefficientBlockSize = SpringDirection::_Count * 3 * 4;
+
+    // Grid geometry - as the object build matrix, with the width rounded up to the vectorization word
+    int mGridWidth;
+    int mGridHeight;
+    size_t mCellCount;
+
+    // The cell of each point
+    std::vector<ElementIndex> mPointCellIndices;
+
+    //
+    // Cell buffers
+    //
+    // Cell buffers are preceded and followed by one extra vectorization word, as the
+    // stencil reaches one cell before the first one (the SW neighbor of the first cell
+    // of row 1) and beyond the last one; cell c is at GetCellData(buffer)[c]
+    //
+
+    static size_t constexpr CellBufferPadding = vectorization_float_count<size_t>;
+
+    static float * GetCellData(Buffer<float> & buffer)
+    {
+        return buffer.data() + CellBufferPadding;
+    }
+
+    static float const * GetCellData(Buffer<float> const & buffer)
+    {
+        return buffer.data() + CellBufferPadding;
+    }
+
+    Buffer<float> mCellPositionXBuffer;
+    Buffer<float> mCellPositionYBuffer;
+    Buffer<float> mCellVelocityXBuffer;
+    Buffer<float> mCellVelocityYBuffer;
+    Buffer<float> mCellSpringForceXBuffer;
+    Buffer<float> mCellSpringForceYBuffer;
+    Buffer<float> mCellExternalForceXBuffer;
+    Buffer<float> mCellExternalForceYBuffer;
+    Buffer<float> mCellIntegrationFactorBuffer; // dt^2/Mass or zero when the point is frozen or the cell is empty
+
+    //
+    // Spring buffers, by block of four cells
+    //
+
+    Buffer<float> mSpringCoefficientBuffer;
+};
+
+/*
+ * Lays out points row by row, as they are in the build point matrix; springs are
+ * left as they are.
+ *
+ * Simulator-specific structure:
+ *  - Points: the width and height of the matrix, followed - for each row - by the
+ *    number of runs of contiguous points in the row, and by the starting column and
+ *    the length of each run.
+ */
+class FSGridLayoutOptimizer : public ILayoutOptimizer
+{
+public:
+
+    LayoutRemap Remap(
+        ObjectBuildPointIndexMatrix const & pointMatrix,
+        std::vector<ObjectBuildPoint> const & points,
+        std::vector<ObjectBuildSpring> const & springs) const override;
+};
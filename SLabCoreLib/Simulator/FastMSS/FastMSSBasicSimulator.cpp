@@ -5,30 +5,36 @@
 ***************************************************************************************/
 #include "FastMSSBasicSimulator.h"
 
+#include "Log.h"
+#include "SysSpecifics.h"
+
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <numeric>
 #include <vector>
 
 FastMSSBasicSimulator::FastMSSBasicSimulator(
     Object const & object,
     SimulationParameters const & simulationParameters,
-    ThreadManager const & /*threadManager*/)
+    ThreadManager const & threadManager)
 {
-    CreateState(object, simulationParameters);
+    CreateState(object, simulationParameters, threadManager);
 }
 
 void FastMSSBasicSimulator::OnStateChanged(
     Object const & object,
     SimulationParameters const & simulationParameters,
-    ThreadManager const & /*threadManager*/)
+    ThreadManager const & threadManager)
 {
-    CreateState(object, simulationParameters);
+    CreateState(object, simulationParameters, threadManager);
 }
 
 void FastMSSBasicSimulator::Update(
     Object & object,
     float /*currentSimulationTime*/,
     SimulationParameters const & simulationParameters,
-    ThreadManager & /*threadManager*/)
+    ThreadManager & threadManager)
 {
     float const dt = simulationParameters.Common.SimulationTimeStepDuration;
 
@@ -62,28 +68,27 @@ void FastMSSBasicSimulator::Update(
 
     float const damping = simulationParameters.FastMSSCommonSimulator.GlobalDamping;
 
-    Eigen::VectorXf const inertialTerm = mM * (currentState + currentVelocities * damping * dt);
+    // Note: all work vectors are pre-sized, hence none of the following allocates
+
+    mGlobalStepRHS = currentState + currentVelocities * (damping * dt); // Just as scratch
+    mInertialTerm.noalias() = mM * mGlobalStepRHS;
 
     //
     // Optimize, alternating between local and global steps
     //
 
     // Save current state as initial state
-    Eigen::VectorXf const initialState = currentState;
+    mInitialState = currentState;
 
     for (size_t i = 0; i < simulationParameters.FastMSSCommonSimulator.NumLocalGlobalStepIterations; ++i)
     {
         // Calculate spring directions based on current state
-        Eigen::VectorXf const springDirections = RunLocalStep(
-            currentState,
-            object.GetSprings());
+        RunLocalStep(threadManager);
 
         // Calculate new current state (updating points' position buffer)
-        currentState = RunGlobalStep(
-            inertialTerm,
-            springDirections,
-            mExternalForces,
-            simulationParameters); 
+        RunGlobalStep(
+            currentState,
+            simulationParameters);
     }
 
     //
@@ -94,24 +99,25 @@ void FastMSSBasicSimulator::Update(
     {
         currentState[2 * p] =
             object.GetPoints().GetFrozenCoefficient(p) * currentState[2 * p]
-            + (1.0f - object.GetPoints().GetFrozenCoefficient(p)) * initialState[2 * p];
+            + (1.0f - object.GetPoints().GetFrozenCoefficient(p)) * mInitialState[2 * p];
         currentState[2 * p + 1] =
             object.GetPoints().GetFrozenCoefficient(p) * currentState[2 * p + 1]
-            + (1.0f - object.GetPoints().GetFrozenCoefficient(p)) * initialState[2 * p + 1];
+            + (1.0f - object.GetPoints().GetFrozenCoefficient(p)) * mInitialState[2 * p + 1];
     }
 
     //
     // Calculate velocities
     //
 
-    currentVelocities = (currentState - initialState) / dt;
+    currentVelocities = (currentState - mInitialState) / dt;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 void FastMSSBasicSimulator::CreateState(
     Object const & object,
-    SimulationParameters const & simulationParameters)
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
 {
     std::vector<Eigen::Triplet<float>> triplets;
     
@@ -120,19 +126,32 @@ void FastMSSBasicSimulator::CreateState(
     auto const nSprings = object.GetSprings().GetElementCount();
 
     //
-    // Compute L
+    // Compute system matrix:
     //
-    //        pa.x  pa.y  ...  pb.x  pb.y
-    //  pa.x   +k               -k
-    //  pa.y         +k               -k
+    //  M + h^2L
+    //
+    // x's are only coupled with x's, and y's with y's, with the very same coefficients;
+    // we thus only build - and factorize - the system matrix of one coordinate, and
+    // solve for both coordinates at once
+    //
+    //        pa          ...  pb
+    //  pa     m + h^2k         -h^2k
     //  ....
-    //  pb.x   -k               +k
-    //  pb.y         -k               +k
+    //  pb     -h^2k            m + h^2k
     //
 
-    mL.resize(2 * nParticles, 2 * nParticles);
+    Eigen::SparseMatrix<float> systemMatrix(nParticles, nParticles);
 
     triplets.clear();
+    for (auto const p : object.GetPoints())
+    {
+        float const m =
+            object.GetPoints().GetMass(p)
+            * simulationParameters.Common.MassAdjustment;
+
+        triplets.emplace_back(p, p, m);
+    }
+
     for (auto const s : object.GetSprings())
     {
         float const k =
@@ -142,21 +161,13 @@ void FastMSSBasicSimulator::CreateState(
         auto const pa = object.GetSprings().GetEndpointAIndex(s);
         auto const pb = object.GetSprings().GetEndpointBIndex(s);
 
-        // x
-        triplets.emplace_back(2 * pa, 2 * pa, 1.0f * k);
-        triplets.emplace_back(2 * pa, 2 * pb, -1.0f * k);
-        triplets.emplace_back(2 * pb, 2 * pa, -1.0f * k);
-        triplets.emplace_back(2 * pb, 2 * pb, 1.0f * k);
-
-        // y
-        triplets.emplace_back(2 * pa + 1, 2 * pa + 1, 1.0f * k);
-        triplets.emplace_back(2 * pa + 1, 2 * pb + 1, -1.0f * k);
-        triplets.emplace_back(2 * pb + 1, 2 * pa + 1, -1.0f * k);
-        triplets.emplace_back(2 * pb + 1, 2 * pb + 1, 1.0f * k);
-
+        triplets.emplace_back(pa, pa, dtSquared * k);
+        triplets.emplace_back(pa, pb, -dtSquared * k);
+        triplets.emplace_back(pb, pa, -dtSquared * k);
+        triplets.emplace_back(pb, pb, dtSquared * k);
     }
 
-    mL.setFromTriplets(triplets.cbegin(), triplets.cend());
+    systemMatrix.setFromTriplets(triplets.cbegin(), triplets.cend());
 
     //
     // Compute J
@@ -168,6 +179,9 @@ void FastMSSBasicSimulator::CreateState(
     //  pb.x   -k
     //  pb.y         -k
     //
+    // We only ever use J in the b vector, where it's multiplied by h^2;
+    // hence we store h^2J
+    //
 
     mJ.resize(2 * nParticles, 2 * nSprings);
 
@@ -182,12 +196,12 @@ void FastMSSBasicSimulator::CreateState(
         auto const pb = object.GetSprings().GetEndpointBIndex(s);
 
         // x
-        triplets.emplace_back(2 * pa, 2 * s, 1.0f * k);
-        triplets.emplace_back(2 * pb, 2 * s, -1.0f * k);
+        triplets.emplace_back(2 * pa, 2 * s, dtSquared * (1.0f * k));
+        triplets.emplace_back(2 * pb, 2 * s, dtSquared * (-1.0f * k));
 
         // y
-        triplets.emplace_back(2 * pa + 1, 2 * s + 1, 1.0f * k);
-        triplets.emplace_back(2 * pb + 1, 2 * s + 1, -1.0f * k);
+        triplets.emplace_back(2 * pa + 1, 2 * s + 1, dtSquared * (1.0f * k));
+        triplets.emplace_back(2 * pb + 1, 2 * s + 1, dtSquared * (-1.0f * k));
     }
 
     mJ.setFromTriplets(triplets.cbegin(), triplets.cend());
@@ -219,13 +233,66 @@ void FastMSSBasicSimulator::CreateState(
     mM.setFromTriplets(triplets.cbegin(), triplets.cend());
 
     //
-    // Pre-factor system matrix:
+    // Factorize system matrix
     //
-    //  M + h^2L
+    // The topology of our object never changes, hence we only calculate the fill-reducing
+    // ordering - and run the symbolic analysis - once, or when the choice of ordering changes;
+    // we then only re-run the numeric factorization when the matrix's coefficients change,
+    // which they don't when e.g. only gravity or forces have changed.
     //
 
-    Eigen::SparseMatrix<float> const A = mM + dtSquared * mL;
-    mCholenskySystemMatrix.compute(A);
+    bool const doUseNestedDissectionOrdering = simulationParameters.FastMSSCommonSimulator.DoUseNestedDissectionOrdering;
+
+    bool const doAnalyze = (mIsSystemMatrixOrderingNestedDissection != doUseNestedDissectionOrdering);
+
+    if (doAnalyze)
+    {
+        if (doUseNestedDissectionOrdering)
+        {
+            auto const ordering = CalculateNestedDissectionOrdering(object);
+
+            mSystemMatrixPermutationInverse.resize(static_cast<Eigen::Index>(nParticles));
+            std::copy(
+                ordering.cbegin(),
+                ordering.cend(),
+                mSystemMatrixPermutationInverse.indices().data());
+        }
+        else
+        {
+            Eigen::AMDOrdering<int> amdOrdering;
+            amdOrdering(systemMatrix, mSystemMatrixPermutationInverse);
+        }
+
+        mSystemMatrixPermutation = mSystemMatrixPermutationInverse.inverse();
+
+        mIsSystemMatrixOrderingNestedDissection = doUseNestedDissectionOrdering;
+    }
+
+    // Same topology, hence same storage order - just check whether any coefficient has changed
+    bool const doFactorize =
+        doAnalyze
+        || !std::equal(
+            systemMatrix.valuePtr(),
+            systemMatrix.valuePtr() + systemMatrix.nonZeros(),
+            mSystemMatrix.valuePtr());
+
+    if (doFactorize)
+    {
+        Eigen::SparseMatrix<float> permutedSystemMatrix;
+        permutedSystemMatrix = systemMatrix.twistedBy(mSystemMatrixPermutation);
+
+        if (doAnalyze)
+        {
+            mCholenskySystemMatrix.analyzePattern(permutedSystemMatrix);
+        }
+
+        mCholenskySystemMatrix.factorize(permutedSystemMatrix);
+
+        mSystemMatrix = std::move(systemMatrix);
+    }
+
+    LogMessage("FastMSSBasicSimulator: ordering=", doUseNestedDissectionOrdering ? "NestedDissection" : "AMD",
+        " doFactorize=", doFactorize, " nnz(L)=", mCholenskySystemMatrix.matrixL().nestedExpression().nonZeros());
 
     //
     // Calculate external forces
@@ -244,41 +311,158 @@ void FastMSSBasicSimulator::CreateState(
         mExternalForces(2 * p) = totalForce.x;
         mExternalForces(2 * p + 1) = totalForce.y;
     }
+
+    //
+    // Allocate work vectors
+    //
+
+    mInertialTerm = Eigen::VectorXf(nParticles * 2);
+    mInitialState = Eigen::VectorXf(nParticles * 2);
+    mGlobalStepRHS = Eigen::VectorXf(nParticles * 2);
+    mGlobalStepSolution = Eigen::MatrixX2f(nParticles, 2);
+    mSpringDirections = Eigen::VectorXf(nSprings * 2);
+
+    //
+    // Prepare local step
+    //
+
+    mLocalStepTasks.clear();
+
+    // Number of 4-spring blocks per thread, assuming we use all parallelism threads
+    ElementCount const numberOfSprings = static_cast<ElementCount>(nSprings);
+    ElementCount const numberOfFourSpringsPerThread = numberOfSprings / (static_cast<ElementCount>(threadManager.GetSimulationParallelism()) * 4);
+
+    size_t const parallelism = (numberOfFourSpringsPerThread > 0)
+        ? threadManager.GetSimulationParallelism()
+        : 1; // Not enough, use just one thread
+
+    ElementIndex springStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const springEnd = (t < parallelism - 1)
+            ? springStart + numberOfFourSpringsPerThread * 4
+            : numberOfSprings;
+
+        mLocalStepTasks.emplace_back(
+            [this, &object, springStart, springEnd]()
+            {
+                CalculateSpringDirections(
+                    object,
+                    springStart,
+                    springEnd);
+            });
+
+        springStart = springEnd;
+    }
+
+    LogMessage("FastMSSBasicSimulator: numSprings=", numberOfSprings, " numberOfFourSpringsPerThread=", numberOfFourSpringsPerThread,
+        " numThreads=", parallelism);
 }
 
-Eigen::VectorXf FastMSSBasicSimulator::RunLocalStep(
-    Eigen::Map<Eigen::VectorXf> const & currentState,
-    Springs const & springs)
+void FastMSSBasicSimulator::RunLocalStep(ThreadManager & threadManager)
 {
     //
     // Calculate optimal spring directions based on current state (fixing positions)
     //
 
-    Eigen::VectorXf springDirections(springs.GetElementCount() * 2);
+    threadManager.GetSimulationThreadPool().Run(mLocalStepTasks);
+}
 
-    for (auto const s : springs)
+void FastMSSBasicSimulator::CalculateSpringDirections(
+    Object const & object,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
+{
+    // This implementation is for 4-float SSE
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(vectorization_float_count<int> >= 4);
+
+    assert(startSpringIndex % 4 == 0);
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(object.GetPoints().GetPositionBuffer());
+    Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+    float * restrict const springDirectionBuffer = mSpringDirections.data();
+
+    __m128 const Zero = _mm_setzero_ps();
+
+    ElementIndex const endSpringIndexVectorized = startSpringIndex + (endSpringIndex - startSpringIndex) / 4 * 4;
+
+    ElementIndex s = startSpringIndex;
+
+    for (; s < endSpringIndexVectorized; s += 4)
+    {
+        // xa - xb, for springs s+0 and s+1: (dx0, dy0, dx1, dy1)
+        __m128 const dis01 = _mm_sub_ps(
+            _mm_loadh_pi(
+                _mm_loadl_pi(Zero, reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 0].PointAIndex * 2)),
+                reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 1].PointAIndex * 2)),
+            _mm_loadh_pi(
+                _mm_loadl_pi(Zero, reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 0].PointBIndex * 2)),
+                reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 1].PointBIndex * 2)));
+
+        // xa - xb, for springs s+2 and s+3: (dx2, dy2, dx3, dy3)
+        __m128 const dis23 = _mm_sub_ps(
+            _mm_loadh_pi(
+                _mm_loadl_pi(Zero, reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 2].PointAIndex * 2)),
+                reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 3].PointAIndex * 2)),
+            _mm_loadh_pi(
+                _mm_loadl_pi(Zero, reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 2].PointBIndex * 2)),
+                reinterpret_cast<__m64 const *>(positionBuffer + endpointsBuffer[s + 3].PointBIndex * 2)));
+
+        __m128 const dis_x = _mm_shuffle_ps(dis01, dis23, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 const dis_y = _mm_shuffle_ps(dis01, dis23, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m128 const sq_len =
+            _mm_add_ps(
+                _mm_mul_ps(dis_x, dis_x),
+                _mm_mul_ps(dis_y, dis_y));
+
+        __m128 const validMask = _mm_cmpgt_ps(sq_len, Zero); // SL==0 => dir==(0, 0), as in vec2f::normalise()
+
+        __m128 const springLength = _mm_sqrt_ps(sq_len);
+        __m128 const restLength = _mm_loadu_ps(restLengthBuffer + s);
+
+        // Store (dx0, dy0, dx1, dy1, dx2, dy2, dx3, dy3) / length * restLength, in the same
+        // order of operations as vec2f::normalise()
+        _mm_storeu_ps(
+            springDirectionBuffer + s * 2,
+            _mm_and_ps(
+                _mm_mul_ps(
+                    _mm_div_ps(dis01, _mm_unpacklo_ps(springLength, springLength)),
+                    _mm_unpacklo_ps(restLength, restLength)),
+                _mm_unpacklo_ps(validMask, validMask)));
+
+        _mm_storeu_ps(
+            springDirectionBuffer + s * 2 + 4,
+            _mm_and_ps(
+                _mm_mul_ps(
+                    _mm_div_ps(dis23, _mm_unpackhi_ps(springLength, springLength)),
+                    _mm_unpackhi_ps(restLength, restLength)),
+                _mm_unpackhi_ps(validMask, validMask)));
+    }
+
+    for (; s < endSpringIndex; ++s)
     {
-        auto const pa = springs.GetEndpointAIndex(s);
-        auto const pb = springs.GetEndpointBIndex(s);
+        auto const pa = endpointsBuffer[s].PointAIndex;
+        auto const pb = endpointsBuffer[s].PointBIndex;
 
-        vec2f const xa = vec2f(currentState[2 * pa], currentState[2 * pa + 1]);
-        vec2f const xb = vec2f(currentState[2 * pb], currentState[2 * pb + 1]);
+        vec2f const xa = vec2f(positionBuffer[2 * pa], positionBuffer[2 * pa + 1]);
+        vec2f const xb = vec2f(positionBuffer[2 * pb], positionBuffer[2 * pb + 1]);
 
         vec2f const dir =
             (xa - xb).normalise()
-            * springs.GetRestLength(s);
+            * restLengthBuffer[s];
 
-        springDirections[2 * s] = dir.x;
-        springDirections[2 * s + 1] = dir.y;
+        springDirectionBuffer[2 * s] = dir.x;
+        springDirectionBuffer[2 * s + 1] = dir.y;
     }
-
-    return springDirections;
 }
 
-Eigen::VectorXf FastMSSBasicSimulator::RunGlobalStep(
-    Eigen::VectorXf const & inertialTerm,
-    Eigen::VectorXf const & springDirections,
-    Eigen::VectorXf const & externalForces,
+void FastMSSBasicSimulator::RunGlobalStep(
+    Eigen::Map<Eigen::VectorXf> & currentState,
     SimulationParameters const & simulationParameters)
 {
     //
@@ -291,15 +475,195 @@ Eigen::VectorXf FastMSSBasicSimulator::RunGlobalStep(
     // Compute b vector (external forces and inertia)
     //
 
-    Eigen::VectorXf const b = 
-        inertialTerm
-        + dtSquared * mJ * springDirections
-        + dtSquared * externalForces;
+    mGlobalStepRHS.noalias() = mJ * mSpringDirections; // J is h^2J
+    mGlobalStepRHS = mInertialTerm + mGlobalStepRHS + dtSquared * mExternalForces;
 
     //
-    // Solve system and return new state
+    // Solve system into new state
+    //
+    // The system matrix is the same for both coordinates, hence we solve for
+    // both of them at once, with a two-column right-hand side:
+    //  [x y] = Pinv * U^-1 * L^-1 * P * [bx by]
     //
 
-    return mCholenskySystemMatrix.solve(b);
+    auto const nParticles = mSystemMatrix.rows();
+
+    assert(mCholenskySystemMatrix.info() == Eigen::Success);
+
+    mGlobalStepSolution.noalias() =
+        mSystemMatrixPermutation
+        * Eigen::Map<CoordinateMatrix const>(mGlobalStepRHS.data(), nParticles, 2);
+
+    mCholenskySystemMatrix.matrixL().solveInPlace(mGlobalStepSolution);
+    mCholenskySystemMatrix.matrixU().solveInPlace(mGlobalStepSolution);
+
+    Eigen::Map<CoordinateMatrix>(currentState.data(), nParticles, 2).noalias() =
+        mSystemMatrixPermutationInverse
+        * mGlobalStepSolution;
 }
 
+std::vector<ElementIndex> FastMSSBasicSimulator::CalculateNestedDissectionOrdering(Object const & object)
+{
+    //
+    // Geometric nested dissection: we recursively split the points at the median of the
+    // widest dimension of their bounding box, take as separator those points of the second
+    // half that are connected to the first half, and order each separator after its halves.
+    //
+    // Note: with our (non-supernodal) factorization, and on the object sizes we deal with,
+    // this yields slightly more fill than AMD does.
+    //
+
+    size_t constexpr LeafSize = 8;
+
+    Points const & points = object.GetPoints();
+    Springs const & springs = object.GetSprings();
+
+    ElementCount const nParticles = points.GetElementCount();
+
+    //
+    // Build adjacency lists
+    //
+
+    std::vector<ElementIndex> adjacencyStarts(nParticles + 1, 0);
+    for (auto const s : springs)
+    {
+        ++adjacencyStarts[springs.GetEndpointAIndex(s) + 1];
+        ++adjacencyStarts[springs.GetEndpointBIndex(s) + 1];
+    }
+
+    for (ElementIndex p = 0; p < nParticles; ++p)
+    {
+        adjacencyStarts[p + 1] += adjacencyStarts[p];
+    }
+
+    std::vector<ElementIndex> adjacency(adjacencyStarts.back());
+    {
+        std::vector<ElementIndex> adjacencyEnds(adjacencyStarts.cbegin(), adjacencyStarts.cend() - 1);
+        for (auto const s : springs)
+        {
+            auto const pa = springs.GetEndpointAIndex(s);
+            auto const pb = springs.GetEndpointBIndex(s);
+
+            adjacency[adjacencyEnds[pa]++] = pb;
+            adjacency[adjacencyEnds[pb]++] = pa;
+        }
+    }
+
+    //
+    // Dissect
+    //
+
+    std::vector<ElementIndex> ordering;
+    ordering.reserve(nParticles);
+
+    std::vector<ElementIndex> pointIndices(nParticles);
+    std::iota(pointIndices.begin(), pointIndices.end(), ElementIndex(0));
+
+    // The partition tag of each point; only meaningful for the points of the partition being dissected
+    std::vector<size_t> partitionTags(nParticles, 0);
+    size_t nextPartitionTag = 1;
+
+    using iterator = std::vector<ElementIndex>::iterator;
+
+    std::function<void(iterator, iterator)> dissect = [&](iterator begin, iterator end)
+    {
+        size_t const n = static_cast<size_t>(std::distance(begin, end));
+        if (n <= LeafSize)
+        {
+            ordering.insert(ordering.end(), begin, end);
+            return;
+        }
+
+        // Find widest dimension
+
+        vec2f minPosition = points.GetPosition(*begin);
+        vec2f maxPosition = minPosition;
+        for (auto it = begin; it != end; ++it)
+        {
+            minPosition.x = std::min(minPosition.x, points.GetPosition(*it).x);
+            minPosition.y = std::min(minPosition.y, points.GetPosition(*it).y);
+            maxPosition.x = std::max(maxPosition.x, points.GetPosition(*it).x);
+            maxPosition.y = std::max(maxPosition.y, points.GetPosition(*it).y);
+        }
+
+        bool const isSplitOnX = (maxPosition.x - minPosition.x) >= (maxPosition.y - minPosition.y);
+
+        // Split at median coordinate, keeping points with the same coordinate - i.e. lattice
+        // rows or columns - on the same side
+
+        auto const getCoordinate = [&points, isSplitOnX](ElementIndex p)
+        {
+            return isSplitOnX ? points.GetPosition(p).x : points.GetPosition(p).y;
+        };
+
+        auto mid = begin + n / 2;
+        std::nth_element(
+            begin,
+            mid,
+            end,
+            [&getCoordinate](ElementIndex p1, ElementIndex p2)
+            {
+                return getCoordinate(p1) < getCoordinate(p2);
+            });
+
+        float const medianCoordinate = getCoordinate(*mid);
+
+        mid = std::partition(
+            begin,
+            end,
+            [&getCoordinate, medianCoordinate](ElementIndex p)
+            {
+                return getCoordinate(p) < medianCoordinate;
+            });
+
+        if (mid == begin)
+        {
+            // Median is the minimum, take it as first half
+            mid = std::partition(
+                begin,
+                end,
+                [&getCoordinate, medianCoordinate](ElementIndex p)
+                {
+                    return getCoordinate(p) <= medianCoordinate;
+                });
+
+            if (mid == end)
+            {
+                // All points have the same coordinate
+                mid = begin + n / 2;
+            }
+        }
+
+        size_t const firstHalfTag = nextPartitionTag++;
+        for (auto it = begin; it != mid; ++it)
+        {
+            partitionTags[*it] = firstHalfTag;
+        }
+
+        // Move separator - i.e. points of second half connected to first half - to the end
+
+        auto const separatorBegin = std::partition(
+            mid,
+            end,
+            [&](ElementIndex p)
+            {
+                for (ElementIndex a = adjacencyStarts[p]; a < adjacencyStarts[p + 1]; ++a)
+                {
+                    if (partitionTags[adjacency[a]] == firstHalfTag)
+                        return false;
+                }
+
+                return true;
+            });
+
+        dissect(begin, mid);
+        dissect(mid, separatorBegin);
+        ordering.insert(ordering.end(), separatorBegin, end);
+    };
+
+    dissect(pointIndices.begin(), pointIndices.end());
+
+    assert(ordering.size() == nParticles);
+
+    return ordering;
+}
\ No newline at end of file
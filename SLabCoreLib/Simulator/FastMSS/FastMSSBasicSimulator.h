@@ -7,11 +7,15 @@
 
 #include "Simulator/Common/ISimulator.h"
 
+#include "ThreadPool.h"
+
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 /*
  * Implementation of "Fast simulation of mass-spring systems", from:
@@ -54,30 +58,62 @@ private:
 
     void CreateState(
         Object const & object,
-        SimulationParameters const & simulationParameters);
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
 
-    // Returns new spring directions
-    Eigen::VectorXf RunLocalStep(
-        Eigen::Map<Eigen::VectorXf> const & currentState,
-        Springs const & springs);
+    // Calculates new spring directions into mSpringDirections
+    void RunLocalStep(ThreadManager & threadManager);
 
-    // Return new positions (state)
-    Eigen::VectorXf RunGlobalStep(
-        Eigen::VectorXf const & inertialTerm,
-        Eigen::VectorXf const & springDirections,
-        Eigen::VectorXf const & externalForces,
+    void CalculateSpringDirections(
+        Object const & object,
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex); // Excluded
+
+    // Calculates new positions (state) into currentState
+    void RunGlobalStep(
+        Eigen::Map<Eigen::VectorXf> & currentState,
         SimulationParameters const & simulationParameters);
 
+    // Returns the points in the order in which they should be eliminated
+    static std::vector<ElementIndex> CalculateNestedDissectionOrdering(Object const & object);
+
+private:
+
+    // Interleaved (x, y) vectors, seen as one row per point
+    using CoordinateMatrix = Eigen::Matrix<float, Eigen::Dynamic, 2, Eigen::RowMajor>;
+
 private:
 
     // External forces
     Eigen::VectorXf mExternalForces;
 
-    // L, J, M matrices
-    Eigen::SparseMatrix<float> mL;
-    Eigen::SparseMatrix<float> mJ;
+    // J, M matrices
+    Eigen::SparseMatrix<float> mJ; // Pre-multiplied by h^2
     Eigen::SparseMatrix<float> mM;
 
-    // System matrix (points coeff in system)
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<float>> mCholenskySystemMatrix;
+    // System matrix (points coeff in system) of either coordinate, as of the last factorization
+    Eigen::SparseMatrix<float> mSystemMatrix;
+
+    // Fill-reducing permutation of the system matrix
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> mSystemMatrixPermutation;
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> mSystemMatrixPermutationInverse;
+    std::optional<bool> mIsSystemMatrixOrderingNestedDissection; // Not set until first analysis
+
+    // Factorization of the permuted system matrix
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<float>, Eigen::Lower, Eigen::NaturalOrdering<int>> mCholenskySystemMatrix;
+
+    //
+    // Work vectors - sized once in CreateState(), so that Update() does not allocate
+    //
+
+    Eigen::VectorXf mInertialTerm;
+    Eigen::VectorXf mInitialState;
+    Eigen::VectorXf mGlobalStepRHS; // b
+    Eigen::MatrixX2f mGlobalStepSolution; // Column-major, as needed by in-place triangular solvers
+
+    // Spring directions, as calculated by the local step
+    Eigen::VectorXf mSpringDirections;
+
+    // Local step tasks, each calculating the directions of a range of springs
+    std::vector<typename ThreadPool::Task> mLocalStepTasks;
 };
\ No newline at end of file
@@ -9,5 +9,6 @@ FastMSSCommonSimulatorParameters::FastMSSCommonSimulatorParameters()
 	: SpringStiffnessCoefficient(36700.0f)
 	, GlobalDamping(1.0f)
 	, NumLocalGlobalStepIterations(10)
+	, DoUseNestedDissectionOrdering(false)
 {
 }
\ No newline at end of file
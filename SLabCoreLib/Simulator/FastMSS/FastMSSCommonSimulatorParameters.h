@@ -23,4 +23,7 @@ struct FastMSSCommonSimulatorParameters
     size_t NumLocalGlobalStepIterations;
     static size_t constexpr MinNumLocalGlobalStepIterations = 1;
     static size_t constexpr MaxNumLocalGlobalStepIterations = 100;
+
+    // Whether the system matrix is ordered with nested dissection rather than with AMD
+    bool DoUseNestedDissectionOrdering;
 };
\ No newline at end of file
@@ -0,0 +1,416 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FastMSSConjugateGradientSimulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+
+/*
+ * An update is one single ThreadPool batch, in which each thread owns a range of points
+ * and runs all of the local-global iterations:
+ *
+ *  save state, calculate constant term of b
+ *  for each local-global iteration:
+ *      calculate spring directions and b, r = b - Ax, z = r/diag(A), p = z
+ *      -- barrier --
+ *      until converged:
+ *          q = Ap
+ *          -- barrier --
+ *          x += alpha p, r -= alpha q, z = r/diag(A)
+ *          -- barrier --
+ *          p = z + beta p
+ *          -- barrier --
+ *  fix frozen points, calculate velocities
+ *
+ * Each thread calculates its own share of the dot products, and each thread then sums up
+ * all of the shares - in the same order - after the barriers; hence, all threads always
+ * agree on alpha, beta, and on convergence. Shares are double-buffered: a thread may be
+ * writing its next shares - e.g. after convergence - while the others are still summing
+ * up the current ones.
+ */
+
+FastMSSConjugateGradientSimulator::FastMSSConjugateGradientSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : mPointSpringsStartIndices()
+    , mPointSprings()
+    , mPointMassBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), 0.0f)
+    , mPointInverseDiagonalBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), 0.0f)
+    , mPointExternalForceBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mPointInitialPositionBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mPointConstantTermBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mResidualBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mPreconditionedResidualBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mSearchDirectionBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mSystemTimesSearchDirectionBuffer(object.GetPoints().GetBufferElementCount(), object.GetPoints().GetElementCount(), vec2f::zero())
+    , mThreadStates()
+    , mParallelRegionTasks()
+    , mPhaseBarrier()
+    , mCurrentObject(nullptr)
+    , mNumLocalGlobalStepIterations(0)
+    , mDt(0.0f)
+    , mDampingDt(0.0f)
+{
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FastMSSConjugateGradientSimulator::OnStateChanged(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void FastMSSConjugateGradientSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Calculate parameters for this update
+    //
+
+    mNumLocalGlobalStepIterations = simulationParameters.FastMSSCommonSimulator.NumLocalGlobalStepIterations;
+
+    mDt = simulationParameters.Common.SimulationTimeStepDuration;
+
+    mDampingDt = simulationParameters.FastMSSCommonSimulator.GlobalDamping * mDt;
+
+    //
+    // Run parallel region
+    //
+
+    mCurrentObject = &object;
+
+    threadManager.GetSimulationThreadPool().Run(mParallelRegionTasks);
+
+    mCurrentObject = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+
+void FastMSSConjugateGradientSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    float const dtSquared = simulationParameters.Common.SimulationTimeStepDuration * simulationParameters.Common.SimulationTimeStepDuration;
+
+    Points const & points = object.GetPoints();
+    Springs const & springs = object.GetSprings();
+
+    ElementCount const numberOfPoints = static_cast<ElementCount>(points.GetElementCount());
+
+    //
+    // Build springs of each point
+    //
+
+    mPointSpringsStartIndices.assign(numberOfPoints + 1, 0);
+
+    for (auto const s : springs)
+    {
+        ++mPointSpringsStartIndices[springs.GetEndpointAIndex(s) + 1];
+        ++mPointSpringsStartIndices[springs.GetEndpointBIndex(s) + 1];
+    }
+
+    for (ElementIndex p = 0; p < numberOfPoints; ++p)
+    {
+        mPointSpringsStartIndices[p + 1] += mPointSpringsStartIndices[p];
+    }
+
+    mPointSprings.clear();
+    mPointSprings.resize(mPointSpringsStartIndices.back(), PointSpring(NoneElementIndex, 0.0f, 0.0f));
+
+    {
+        std::vector<ElementIndex> pointSpringsEndIndices(mPointSpringsStartIndices.cbegin(), mPointSpringsStartIndices.cend() - 1);
+
+        for (auto const s : springs)
+        {
+            float const k =
+                simulationParameters.FastMSSCommonSimulator.SpringStiffnessCoefficient
+                * springs.GetMaterialStiffness(s);
+
+            auto const pa = springs.GetEndpointAIndex(s);
+            auto const pb = springs.GetEndpointBIndex(s);
+
+            mPointSprings[pointSpringsEndIndices[pa]++] = PointSpring(pb, dtSquared * k, springs.GetRestLength(s));
+            mPointSprings[pointSpringsEndIndices[pb]++] = PointSpring(pa, dtSquared * k, springs.GetRestLength(s));
+        }
+    }
+
+    //
+    // Initialize point buffers
+    //
+
+    for (auto const p : points)
+    {
+        float const m =
+            points.GetMass(p)
+            * simulationParameters.Common.MassAdjustment;
+
+        mPointMassBuffer[p] = m;
+
+        // Diagonal of M + h^2L
+        float diagonal = m;
+        for (ElementIndex ps = mPointSpringsStartIndices[p]; ps < mPointSpringsStartIndices[p + 1]; ++ps)
+        {
+            diagonal += mPointSprings[ps].StiffnessCoefficient;
+        }
+
+        mPointInverseDiagonalBuffer[p] = 1.0f / diagonal;
+
+        mPointExternalForceBuffer[p] =
+            (
+                // Gravity
+                simulationParameters.Common.AssignedGravity * m
+                // External forces
+                + points.GetAssignedForce(p)
+            ) * dtSquared;
+    }
+
+    //
+    // Prepare threads
+    //
+
+    mThreadStates.clear();
+    mParallelRegionTasks.clear();
+
+    // Number of points per thread, rounded to a couple of cache lines
+    // so that threads don't share cache lines while updating vectors
+    ElementCount constexpr PointGranularity = 16;
+    size_t const parallelism = std::max(
+        std::min(
+            threadManager.GetSimulationParallelism(),
+            static_cast<size_t>(numberOfPoints / PointGranularity)),
+        size_t(1));
+    ElementCount const numberOfPointsPerThread =
+        (numberOfPoints / static_cast<ElementCount>(parallelism) + PointGranularity - 1) / PointGranularity * PointGranularity;
+
+    ElementIndex pointStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const pointEnd = (t < parallelism - 1)
+            ? std::min(pointStart + numberOfPointsPerThread, numberOfPoints)
+            : numberOfPoints;
+
+        mThreadStates.emplace_back(pointStart, pointEnd);
+
+        mParallelRegionTasks.emplace_back(
+            [this, t]()
+            {
+                assert(mCurrentObject != nullptr);
+
+                RunParallelRegion(
+                    *mCurrentObject,
+                    t);
+            });
+
+        pointStart = pointEnd;
+    }
+
+    mPhaseBarrier.Reset(parallelism);
+
+    LogMessage("FastMSSConjugateGradientSimulator: numSprings=", springs.GetElementCount(), " numberOfPointsPerThread=", numberOfPointsPerThread,
+        " numThreads=", parallelism);
+}
+
+void FastMSSConjugateGradientSimulator::RunParallelRegion(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState & threadState = mThreadStates[threadIndex];
+
+    ElementIndex const startPointIndex = threadState.StartPointIndex;
+    ElementIndex const endPointIndex = threadState.EndPointIndex;
+
+    vec2f * restrict const positionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f * restrict const velocityBuffer = object.GetPoints().GetVelocityBuffer();
+    float const * restrict const frozenCoefficientBuffer = object.GetPoints().GetFrozenCoefficientBuffer();
+
+    ElementIndex const * restrict const pointSpringsStartIndices = mPointSpringsStartIndices.data();
+    PointSpring const * restrict const pointSprings = mPointSprings.data();
+
+    float const * restrict const massBuffer = mPointMassBuffer.data();
+    float const * restrict const inverseDiagonalBuffer = mPointInverseDiagonalBuffer.data();
+    vec2f const * restrict const externalForceBuffer = mPointExternalForceBuffer.data();
+    vec2f * restrict const initialPositionBuffer = mPointInitialPositionBuffer.data();
+    vec2f * restrict const constantTermBuffer = mPointConstantTermBuffer.data();
+
+    vec2f * restrict const r = mResidualBuffer.data();
+    vec2f * restrict const z = mPreconditionedResidualBuffer.data();
+    vec2f * restrict const p = mSearchDirectionBuffer.data();
+    vec2f * restrict const q = mSystemTimesSearchDirectionBuffer.data();
+
+    // Partial sums slot, toggled by all threads after each reduction
+    size_t slot = 0;
+
+    //
+    // Calculate constant term of b:
+    //
+    //  M * q(n) + d * v(n) * dt + h^2 * fext
+    //
+    // (see FastMSSBasicSimulator for the inertial term)
+    //
+
+    for (ElementIndex i = startPointIndex; i < endPointIndex; ++i)
+    {
+        initialPositionBuffer[i] = positionBuffer[i];
+
+        constantTermBuffer[i] =
+            (positionBuffer[i] + velocityBuffer[i] * mDampingDt) * massBuffer[i]
+            + externalForceBuffer[i];
+    }
+
+    for (size_t iter = 0; iter < mNumLocalGlobalStepIterations; ++iter)
+    {
+        //
+        // Local step, fused with calculation of b and of initial residual:
+        //
+        //  b = constantTerm + h^2 * J * d
+        //  r = b - A * x
+        //
+
+        {
+            float rz = 0.0f;
+            float rr = 0.0f;
+            float bb = 0.0f;
+
+            for (ElementIndex i = startPointIndex; i < endPointIndex; ++i)
+            {
+                vec2f b = constantTermBuffer[i];
+                vec2f ax = positionBuffer[i] * massBuffer[i];
+
+                for (ElementIndex ps = pointSpringsStartIndices[i]; ps < pointSpringsStartIndices[i + 1]; ++ps)
+                {
+                    vec2f const displacement = positionBuffer[i] - positionBuffer[pointSprings[ps].OtherEndpointIndex];
+
+                    // Optimal spring direction, with this point as endpoint A
+                    b += displacement.normalise() * pointSprings[ps].RestLength * pointSprings[ps].StiffnessCoefficient;
+
+                    ax += displacement * pointSprings[ps].StiffnessCoefficient;
+                }
+
+                r[i] = b - ax;
+                z[i] = r[i] * inverseDiagonalBuffer[i];
+                p[i] = z[i];
+
+                rz += r[i].dot(z[i]);
+                rr += r[i].dot(r[i]);
+                bb += b.dot(b);
+            }
+
+            threadState.PartialSums[slot] = { rz, rr, bb };
+        }
+
+        mPhaseBarrier.ArriveAndWait();
+
+        float rz = SumPartials(slot, 0);
+        float rr = SumPartials(slot, 1);
+        float const toleranceSquared = std::max(
+            rr * ConjugateGradientRelativeTolerance * ConjugateGradientRelativeTolerance,
+            SumPartials(slot, 2) * ConjugateGradientPrecisionTolerance * ConjugateGradientPrecisionTolerance);
+
+        slot ^= 1;
+
+        //
+        // Global step: conjugate gradient
+        //
+
+        for (size_t cgIter = 0; cgIter < MaxConjugateGradientIterations && rr > toleranceSquared; ++cgIter)
+        {
+            // q = A * p
+
+            {
+                float pq = 0.0f;
+
+                for (ElementIndex i = startPointIndex; i < endPointIndex; ++i)
+                {
+                    vec2f ap = p[i] * massBuffer[i];
+
+                    for (ElementIndex ps = pointSpringsStartIndices[i]; ps < pointSpringsStartIndices[i + 1]; ++ps)
+                    {
+                        ap += (p[i] - p[pointSprings[ps].OtherEndpointIndex]) * pointSprings[ps].StiffnessCoefficient;
+                    }
+
+                    q[i] = ap;
+
+                    pq += p[i].dot(ap);
+                }
+
+                threadState.PartialSums[slot][0] = pq;
+            }
+
+            mPhaseBarrier.ArriveAndWait();
+
+            float const alpha = rz / SumPartials(slot, 0);
+
+            slot ^= 1;
+
+            // x += alpha * p; r -= alpha * q; z = M^-1 * r
+
+            {
+                float newRz = 0.0f;
+                float newRr = 0.0f;
+
+                for (ElementIndex i = startPointIndex; i < endPointIndex; ++i)
+                {
+                    positionBuffer[i] += p[i] * alpha;
+                    r[i] -= q[i] * alpha;
+                    z[i] = r[i] * inverseDiagonalBuffer[i];
+
+                    newRz += r[i].dot(z[i]);
+                    newRr += r[i].dot(r[i]);
+                }
+
+                threadState.PartialSums[slot][0] = newRz;
+                threadState.PartialSums[slot][1] = newRr;
+            }
+
+            mPhaseBarrier.ArriveAndWait();
+
+            float const newRz = SumPartials(slot, 0);
+            rr = SumPartials(slot, 1);
+
+            slot ^= 1;
+
+            if (rr <= toleranceSquared)
+            {
+                // Converged
+                break;
+            }
+
+            // p = z + beta * p
+
+            float const beta = newRz / rz;
+            rz = newRz;
+
+            for (ElementIndex i = startPointIndex; i < endPointIndex; ++i)
+            {
+                p[i] = z[i] + p[i] * beta;
+            }
+
+            mPhaseBarrier.ArriveAndWait();
+        }
+    }
+
+    //
+    // Fix points, and calculate velocities
+    //
+
+    for (ElementIndex i = startPointIndex; i < endPointIndex; ++i)
+    {
+        positionBuffer[i] =
+            positionBuffer[i] * frozenCoefficientBuffer[i]
+            + initialPositionBuffer[i] * (1.0f - frozenCoefficientBuffer[i]);
+
+        velocityBuffer[i] = (positionBuffer[i] - initialPositionBuffer[i]) / mDt;
+    }
+}
@@ -0,0 +1,168 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Simulator/Common/ISimulator.h"
+
+#include "Buffer.h"
+#include "ThreadBarrier.h"
+#include "ThreadPool.h"
+#include "Vectors.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Same local-global algorithm as in the "Fast MSS - Basic" simulator, with the
+ * global step solved with a Jacobi-preconditioned conjugate gradient, rather
+ * than with a Cholesky factorization.
+ *
+ * The system matrix is never built: it is applied straight from each point's
+ * springs, and the local step is fused with the calculation of the right-hand
+ * side. The solver is warm-started from the current state, and memory is linear
+ * in the number of springs.
+ */
+class FastMSSConjugateGradientSimulator final : public ISimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "Fast MSS - Conjugate Gradient";
+    }
+
+public:
+
+    FastMSSConjugateGradientSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    //////////////////////////////////////////////////////////
+    // ISimulator
+    //////////////////////////////////////////////////////////
+
+    void OnStateChanged(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void RunParallelRegion(
+        Object & object,
+        size_t threadIndex);
+
+    // Sums the partial sums of all threads, always in the same order
+    float SumPartials(
+        size_t slot,
+        size_t index) const
+    {
+        float sum = 0.0f;
+        for (auto const & threadState : mThreadStates)
+        {
+            sum += threadState.PartialSums[slot][index];
+        }
+
+        return sum;
+    }
+
+private:
+
+    // Max number of conjugate gradient iterations per global step
+    static size_t constexpr MaxConjugateGradientIterations = 200;
+
+    // We stop iterating once the residual has been reduced by this factor...
+    static float constexpr ConjugateGradientRelativeTolerance = 1e-4f;
+
+    // ...or once |r| <= tolerance * |b|, beyond which we'd just be chasing float round-off,
+    // since b is dominated by the inertial term
+    static float constexpr ConjugateGradientPrecisionTolerance = 1e-7f;
+
+    //
+    // Springs of each point, as adjacency lists
+    //
+
+    struct PointSpring
+    {
+        ElementIndex OtherEndpointIndex;
+        float StiffnessCoefficient; // h^2k
+        float RestLength;
+
+        PointSpring(
+            ElementIndex otherEndpointIndex,
+            float stiffnessCoefficient,
+            float restLength)
+            : OtherEndpointIndex(otherEndpointIndex)
+            , StiffnessCoefficient(stiffnessCoefficient)
+            , RestLength(restLength)
+        {}
+    };
+
+    std::vector<ElementIndex> mPointSpringsStartIndices; // One more than points
+    std::vector<PointSpring> mPointSprings;
+
+    //
+    // Point buffers
+    //
+
+    Buffer<float> mPointMassBuffer;
+    Buffer<float> mPointInverseDiagonalBuffer; // Jacobi preconditioner: 1/(m + h^2 sum(k))
+    Buffer<vec2f> mPointExternalForceBuffer; // h^2f
+    Buffer<vec2f> mPointInitialPositionBuffer;
+    Buffer<vec2f> mPointConstantTermBuffer; // Inertial term and external forces
+
+    // Conjugate gradient vectors
+    Buffer<vec2f> mResidualBuffer; // r
+    Buffer<vec2f> mPreconditionedResidualBuffer; // z
+    Buffer<vec2f> mSearchDirectionBuffer; // p
+    Buffer<vec2f> mSystemTimesSearchDirectionBuffer; // q = Ap
+
+    //
+    // Threading
+    //
+
+    struct alignas(64) ThreadState // Own cache line, as partial sums are written at each phase
+    {
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex; // Excluded
+
+        // Partial dot products; double-buffered, as a thread may only wait
+        // for the others after it has written its next partial sums
+        std::array<std::array<float, 3>, 2> PartialSums;
+
+        ThreadState(
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex)
+            : StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+            , PartialSums()
+        {}
+    };
+
+    std::vector<ThreadState> mThreadStates;
+    std::vector<typename ThreadPool::Task> mParallelRegionTasks;
+    ThreadBarrier mPhaseBarrier;
+
+    // Current update's object and parameters
+    Object * mCurrentObject;
+    size_t mNumLocalGlobalStepIterations;
+    float mDt;
+    float mDampingDt;
+};
@@ -0,0 +1,244 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "GaussSeidelByPointAVX2Simulator.h"
+
+#include "Log.h"
+
+#include <cassert>
+
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#include <immintrin.h>
+#endif
+
+GaussSeidelByPointAVX2Simulator::GaussSeidelByPointAVX2Simulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : GaussSeidelByPointSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mPointNeighboursBuffer(new PointNeighbours[object.GetPoints().GetBufferElementCount()])
+    , mPointExtraSpringBuffer(object.GetPoints().GetBufferElementCount(), 0, Points::ConnectedSpring())
+    , mIsAVX2Supported(is_avx2_fma_supported())
+{
+    LogMessage("GaussSeidelByPointAVX2Simulator: isAVX2Supported=", mIsAVX2Supported ? "YES" : "NO");
+
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void GaussSeidelByPointAVX2Simulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    GaussSeidelByPointSimulator::CreateState(object, simulationParameters, threadManager);
+
+    //
+    // Build neighbour table
+    //
+
+    Points const & points = object.GetPoints();
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+
+    for (ElementIndex pointIndex = 0; pointIndex < points.GetBufferElementCount(); ++pointIndex)
+    {
+        PointNeighbours & neighbours = mPointNeighboursBuffer[pointIndex];
+        mPointExtraSpringBuffer[pointIndex] = Points::ConnectedSpring();
+
+        size_t s = 0;
+
+        if (pointIndex < points.GetElementCount())
+        {
+            for (auto const & connectedSpring : points.GetConnectedSprings(pointIndex))
+            {
+                if (s < NeighbourSlotCount)
+                {
+                    neighbours.OtherEndpointIndex[s] = connectedSpring.OtherEndpointIndex;
+                    neighbours.RestLength[s] = restLengthBuffer[connectedSpring.SpringIndex];
+                    neighbours.StiffnessCoefficient[s] = mSpringStiffnessCoefficientBuffer[connectedSpring.SpringIndex];
+                    neighbours.DampingCoefficient[s] = mSpringDampingCoefficientBuffer[connectedSpring.SpringIndex];
+                    ++s;
+                }
+                else
+                {
+                    assert(mPointExtraSpringBuffer[pointIndex].SpringIndex == NoneElementIndex);
+                    mPointExtraSpringBuffer[pointIndex] = connectedSpring;
+                }
+            }
+        }
+
+        for (; s < NeighbourSlotCount; ++s)
+        {
+            neighbours.OtherEndpointIndex[s] = pointIndex;
+            neighbours.RestLength[s] = 0.0f;
+            neighbours.StiffnessCoefficient[s] = 0.0f;
+            neighbours.DampingCoefficient[s] = 0.0f;
+        }
+    }
+}
+
+void GaussSeidelByPointAVX2Simulator::RelaxSpringsRange(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float velocityFactor)
+{
+    if (mIsAVX2Supported)
+    {
+        RelaxSpringsRangeAVX2(
+            object,
+            startPointIndex,
+            endPointIndex,
+            velocityFactor);
+    }
+    else
+    {
+        GaussSeidelByPointSimulator::RelaxSpringsRange(
+            object,
+            startPointIndex,
+            endPointIndex,
+            velocityFactor);
+    }
+}
+
+FS_TARGET_AVX2_FMA void GaussSeidelByPointAVX2Simulator::RelaxSpringsRangeAVX2(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float velocityFactor)
+{
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+    static_assert(NeighbourSlotCount == 8);
+
+    vec2f * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
+    vec2f * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
+    float const * const restrict integrationFactorBuffer = mPointIntegrationFactorBuffer.data();
+
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+    float const * restrict const stiffnessCoefficientBuffer = mSpringStiffnessCoefficientBuffer.data();
+    float const * restrict const dampingCoefficientBuffer = mSpringDampingCoefficientBuffer.data();
+
+    // Components are gathered via the index of the x component
+    float const * const positionXBase = reinterpret_cast<float const *>(pointPositionBuffer);
+    float const * const positionYBase = positionXBase + 1;
+    float const * const velocityXBase = reinterpret_cast<float const *>(pointVelocityBuffer);
+    float const * const velocityYBase = velocityXBase + 1;
+
+    __m256 const Zero = _mm256_setzero_ps();
+
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
+    {
+        PointNeighbours const & neighbours = mPointNeighboursBuffer[pointIndex];
+
+        vec2f const thisPointPosition = pointPositionBuffer[pointIndex];
+        vec2f const thisPointVelocity = pointVelocityBuffer[pointIndex];
+
+        // Gather other endpoints
+        __m256i const otherEndpointComponentIndex_8 = _mm256_slli_epi32(
+            _mm256_load_si256(reinterpret_cast<__m256i const *>(neighbours.OtherEndpointIndex)),
+            1);
+
+        // vec2f const displacement = pointPositionBuffer[otherEndpointIndex] - thisPointPosition;
+        __m256 const displacementX_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(positionXBase, otherEndpointComponentIndex_8, 4),
+            _mm256_set1_ps(thisPointPosition.x));
+        __m256 const displacementY_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(positionYBase, otherEndpointComponentIndex_8, 4),
+            _mm256_set1_ps(thisPointPosition.y));
+
+        // float const displacementLength = displacement.length();
+        __m256 const displacementLength_8 = _mm256_sqrt_ps(
+            _mm256_fmadd_ps(
+                displacementX_8,
+                displacementX_8,
+                _mm256_mul_ps(displacementY_8, displacementY_8)));
+
+        // vec2f const springDir = displacement.normalise(displacementLength);
+        //
+        // Unused slots have zero length, and zero direction
+        __m256 const validMask_8 = _mm256_cmp_ps(displacementLength_8, Zero, _CMP_GT_OQ);
+        __m256 const springDirX_8 = _mm256_and_ps(
+            _mm256_div_ps(displacementX_8, displacementLength_8),
+            validMask_8);
+        __m256 const springDirY_8 = _mm256_and_ps(
+            _mm256_div_ps(displacementY_8, displacementLength_8),
+            validMask_8);
+
+        // float const fSpring =
+        //     (displacementLength - restLengthBuffer[connectedSpring.SpringIndex])
+        //     * stiffnessCoefficientBuffer[connectedSpring.SpringIndex];
+        __m256 const fSpring_8 = _mm256_mul_ps(
+            _mm256_sub_ps(
+                displacementLength_8,
+                _mm256_load_ps(neighbours.RestLength)),
+            _mm256_load_ps(neighbours.StiffnessCoefficient));
+
+        // vec2f const relVelocity = pointVelocityBuffer[otherEndpointIndex] - thisPointVelocity;
+        __m256 const relVelocityX_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(velocityXBase, otherEndpointComponentIndex_8, 4),
+            _mm256_set1_ps(thisPointVelocity.x));
+        __m256 const relVelocityY_8 = _mm256_sub_ps(
+            _mm256_i32gather_ps(velocityYBase, otherEndpointComponentIndex_8, 4),
+            _mm256_set1_ps(thisPointVelocity.y));
+
+        // float const fDamp =
+        //     relVelocity.dot(springDir)
+        //     * dampingCoefficientBuffer[connectedSpring.SpringIndex];
+        __m256 const fDamp_8 = _mm256_mul_ps(
+            _mm256_fmadd_ps(
+                relVelocityX_8,
+                springDirX_8,
+                _mm256_mul_ps(relVelocityY_8, springDirY_8)),
+            _mm256_load_ps(neighbours.DampingCoefficient));
+
+        // springForces += springDir * (fSpring + fDamp);
+        __m256 const f_8 = _mm256_add_ps(fSpring_8, fDamp_8);
+        __m256 const forceX_8 = _mm256_mul_ps(springDirX_8, f_8);
+        __m256 const forceY_8 = _mm256_mul_ps(springDirY_8, f_8);
+
+        // Sum the eight slots: interleave x and y in each lane, then fold
+        __m256 const forceXY_4 = _mm256_hadd_ps(forceX_8, forceY_8); // x01, x23, y01, y23 | x45, x67, y45, y67
+        __m128 const forceXY_2 = _mm_add_ps(
+            _mm256_castps256_ps128(forceXY_4),
+            _mm256_extractf128_ps(forceXY_4, 1)); // x0145, x2367, y0145, y2367
+        __m128 const forceXY_1 = _mm_hadd_ps(forceXY_2, forceXY_2); // x, y, x, y
+
+        vec2f springForces;
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&springForces), forceXY_1);
+
+        //
+        // Extra spring, if any
+        //
+
+        Points::ConnectedSpring const & extraSpring = mPointExtraSpringBuffer[pointIndex];
+        if (extraSpring.SpringIndex != NoneElementIndex)
+        {
+            vec2f const displacement = pointPositionBuffer[extraSpring.OtherEndpointIndex] - thisPointPosition;
+            float const displacementLength = displacement.length();
+            vec2f const springDir = displacement.normalise(displacementLength);
+
+            float const fSpring =
+                (displacementLength - restLengthBuffer[extraSpring.SpringIndex])
+                * stiffnessCoefficientBuffer[extraSpring.SpringIndex];
+
+            vec2f const relVelocity = pointVelocityBuffer[extraSpring.OtherEndpointIndex] - thisPointVelocity;
+            float const fDamp =
+                relVelocity.dot(springDir)
+                * dampingCoefficientBuffer[extraSpring.SpringIndex];
+
+            springForces += springDir * (fSpring + fDamp);
+        }
+
+        // Integrate spring forces and update point's velocity
+        vec2f const deltaPos = springForces * integrationFactorBuffer[pointIndex];
+        pointPositionBuffer[pointIndex] += deltaPos;
+        pointVelocityBuffer[pointIndex] += deltaPos * velocityFactor;
+    }
+}
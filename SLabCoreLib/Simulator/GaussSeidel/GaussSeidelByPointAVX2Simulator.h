@@ -0,0 +1,97 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GaussSeidelByPointMTColoredSimulator.h"
+#include "GaussSeidelByPointSimulator.h"
+
+#include "Simulator/Common/ISimulator.h"
+#include "Points.h"
+#include "SysSpecifics.h"
+
+#include <memory>
+#include <string>
+
+/*
+ * Simulator implementing the same Gauss-Seidel solve per-point as the
+ * "By Point" simulator, with all the springs of a point relaxed at once
+ * with AVX2 and FMA.
+ *
+ * Instead of walking the point's connected springs and reading spring
+ * buffers at scattered indices, the kernel reads a per-point table of
+ * eight neighbour slots, holding - structure-of-arrays - the other endpoint
+ * index and the spring's rest length, stiffness and damping coefficients.
+ *
+ * Points are laid out by color as in the "MT - Colored" simulator: as consecutive
+ * points then share no springs, the relaxation of a point does not have to wait
+ * for the position just written by the previous one, and the CPU may overlap
+ * the (long) dependency chains of successive points.
+ *
+ * Falls back to the "By Point" implementation when the CPU does not
+ * support AVX2 and FMA.
+ */
+class GaussSeidelByPointAVX2Simulator : public GaussSeidelByPointSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "Gauss-Seidel - By Point - AVX2";
+    }
+
+    using layout_optimizer = GaussSeidelByPointColoringLayoutOptimizer;
+
+public:
+
+    GaussSeidelByPointAVX2Simulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+private:
+
+    void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    void RelaxSpringsRange(
+        Object & object,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float velocityFactor) override;
+
+    FS_TARGET_AVX2_FMA void RelaxSpringsRangeAVX2(
+        Object & object,
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float velocityFactor);
+
+private:
+
+    static size_t constexpr NeighbourSlotCount = 8;
+
+    /*
+     * The neighbours of a point; unused slots point back to the point itself, and
+     * have zero coefficients, so that they contribute no force.
+     */
+    struct alignas(32) PointNeighbours
+    {
+        ElementIndex OtherEndpointIndex[NeighbourSlotCount];
+        float RestLength[NeighbourSlotCount];
+        float StiffnessCoefficient[NeighbourSlotCount];
+        float DampingCoefficient[NeighbourSlotCount];
+    };
+
+    std::unique_ptr<PointNeighbours[]> mPointNeighboursBuffer;
+
+    // Springs in excess of the neighbour slots - i.e. rope springs of
+    // points with all eight neighbours - relaxed after the neighbours
+    static_assert(SimulationParameters::MaxSpringsPerPoint - NeighbourSlotCount == 1);
+    Buffer<Points::ConnectedSpring> mPointExtraSpringBuffer;
+
+    bool const mIsAVX2Supported;
+};
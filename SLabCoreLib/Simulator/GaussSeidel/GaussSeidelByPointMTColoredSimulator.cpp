@@ -0,0 +1,285 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "GaussSeidelByPointMTColoredSimulator.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+/*
+ * An update is one single ThreadPool batch, in which each thread runs all the
+ * mechanical dynamics iterations:
+ *
+ *  for each iteration:
+ *      integrate own points
+ *      -- barrier --
+ *      for each color:
+ *          relax own points of this color
+ *          -- barrier --
+ */
+
+GaussSeidelByPointMTColoredSimulator::GaussSeidelByPointMTColoredSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : GaussSeidelByPointSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mThreadStates()
+    , mParallelRegionTasks()
+    , mPhaseBarrier()
+    , mCurrentObject(nullptr)
+    , mNumMechanicalDynamicsIterations(0)
+    , mDt(0.0f)
+    , mVelocityFactor(0.0f)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void GaussSeidelByPointMTColoredSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Calculate parameters for this update
+    //
+
+    mNumMechanicalDynamicsIterations = simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations;
+    mDt = CalculateDt(simulationParameters);
+    mVelocityFactor = CalculateVelocityFactor(simulationParameters);
+
+    //
+    // Run parallel region
+    //
+
+    mCurrentObject = &object;
+
+    threadManager.GetSimulationThreadPool().Run(mParallelRegionTasks);
+
+    mCurrentObject = nullptr;
+}
+
+void GaussSeidelByPointMTColoredSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    GaussSeidelByPointSimulator::CreateState(object, simulationParameters, threadManager);
+
+    // Clear threading state
+    mThreadStates.clear();
+    mParallelRegionTasks.clear();
+
+    // Number of points per thread, rounded to a couple of cache lines
+    // so that threads don't share cache lines while updating points
+    ElementCount constexpr PointGranularity = 16;
+    ElementCount const numberOfPoints = static_cast<ElementCount>(object.GetPoints().GetElementCount());
+
+    size_t parallelism;
+    if (numberOfPoints / static_cast<ElementCount>(threadManager.GetSimulationParallelism()) >= PointGranularity)
+    {
+        parallelism = threadManager.GetSimulationParallelism();
+    }
+    else
+    {
+        // Not enough, use just one thread
+        parallelism = 1;
+    }
+
+    ElementCount const numberOfPointsPerThread =
+        (numberOfPoints / static_cast<ElementCount>(parallelism) + PointGranularity - 1) / PointGranularity * PointGranularity;
+
+    ElementIndex pointStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const pointEnd = (t < parallelism - 1)
+            ? std::min(pointStart + numberOfPointsPerThread, numberOfPoints)
+            : numberOfPoints;
+
+        mThreadStates.emplace_back(pointStart, pointEnd);
+
+        mParallelRegionTasks.emplace_back(
+            [this, t]()
+            {
+                assert(mCurrentObject != nullptr);
+
+                RunParallelRegion(
+                    *mCurrentObject,
+                    t);
+            });
+
+        pointStart = pointEnd;
+    }
+
+    //
+    // Split each color among threads, in units of PointGranularity points
+    //
+
+    auto const & pointBlockSizes = object.GetSimulatorSpecificStructure().PointProcessingBlockSizes;
+
+    ElementIndex colorStart = 0;
+    for (ElementCount const colorPointCount : pointBlockSizes)
+    {
+        ElementIndex const colorEnd = colorStart + colorPointCount;
+
+        ElementCount const numberOfUnits = (colorPointCount + PointGranularity - 1) / PointGranularity;
+
+        for (size_t t = 0; t < parallelism; ++t)
+        {
+            ElementIndex const unitStart = static_cast<ElementIndex>(numberOfUnits * t / parallelism);
+            ElementIndex const unitEnd = static_cast<ElementIndex>(numberOfUnits * (t + 1) / parallelism);
+
+            mThreadStates[t].ColorPointRanges.emplace_back(
+                std::min(colorStart + unitStart * PointGranularity, colorEnd),
+                std::min(colorStart + unitEnd * PointGranularity, colorEnd));
+        }
+
+        colorStart = colorEnd;
+    }
+
+    assert(colorStart == numberOfPoints);
+
+    mPhaseBarrier.Reset(parallelism);
+
+    LogMessage("GaussSeidelByPointMTColoredSimulator: numPoints=", numberOfPoints, " numColors=", pointBlockSizes.size(),
+        " numberOfPointsPerThread=", numberOfPointsPerThread, " numThreads=", parallelism);
+}
+
+void GaussSeidelByPointMTColoredSimulator::RunParallelRegion(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState const & threadState = mThreadStates[threadIndex];
+
+    for (size_t i = 0; i < mNumMechanicalDynamicsIterations; ++i)
+    {
+        // Integrate external forces and current velocities
+        IntegrateRange(
+            object,
+            threadState.IntegrationPointRange.StartPointIndex,
+            threadState.IntegrationPointRange.EndPointIndex,
+            mDt,
+            mVelocityFactor);
+
+        // Wait for all positions to be in
+        mPhaseBarrier.ArriveAndWait();
+
+        for (size_t c = 0; c < threadState.ColorPointRanges.size(); ++c)
+        {
+            // Relax springs of the points of this color
+            RelaxSpringsRange(
+                object,
+                threadState.ColorPointRanges[c].StartPointIndex,
+                threadState.ColorPointRanges[c].EndPointIndex,
+                mVelocityFactor);
+
+            // Wait for all points of this color to be in, unless this is the last
+            // color of the last iteration, in which case the end of the batch does
+            // it for us
+            if (c < threadState.ColorPointRanges.size() - 1 || i < mNumMechanicalDynamicsIterations - 1)
+            {
+                mPhaseBarrier.ArriveAndWait();
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////
+
+ILayoutOptimizer::LayoutRemap GaussSeidelByPointColoringLayoutOptimizer::Remap(
+    ObjectBuildPointIndexMatrix const & pointMatrix,
+    std::vector<ObjectBuildPoint> const & points,
+    std::vector<ObjectBuildSpring> const & springs) const
+{
+    //
+    // 1. Visit points by lattice parity class, row-major within each class
+    //
+
+    std::vector<ElementIndex> visitOrder;
+    visitOrder.reserve(points.size());
+
+    std::array<std::pair<int, int>, 4> constexpr ParityClasses{ {{0, 0}, {1, 0}, {0, 1}, {1, 1}} };
+    for (auto const & parityClass : ParityClasses)
+    {
+        for (int y = parityClass.second; y < pointMatrix.height; y += 2)
+        {
+            for (int x = parityClass.first; x < pointMatrix.width; x += 2)
+            {
+                if (pointMatrix[{x, y}])
+                {
+                    visitOrder.push_back(*pointMatrix[{x, y}]);
+                }
+            }
+        }
+    }
+
+    assert(visitOrder.size() == points.size());
+
+    //
+    // 2. Greedily color points, so that no two points of the same color
+    //    are connected by a spring
+    //
+
+    ElementIndex constexpr NoColor = NoneElementIndex;
+    std::vector<ElementIndex> pointColors(points.size(), NoColor);
+    std::vector<std::vector<ElementIndex>> colors;
+
+    std::vector<bool> isColorTaken;
+    for (ElementIndex p : visitOrder)
+    {
+        isColorTaken.assign(colors.size(), false);
+        for (ElementIndex s : points[p].ConnectedSprings)
+        {
+            ElementIndex const otherP = (springs[s].PointAIndex == p) ? springs[s].PointBIndex : springs[s].PointAIndex;
+            if (pointColors[otherP] != NoColor)
+            {
+                isColorTaken[pointColors[otherP]] = true;
+            }
+        }
+
+        ElementIndex const c = static_cast<ElementIndex>(
+            std::find(isColorTaken.cbegin(), isColorTaken.cend(), false) - isColorTaken.cbegin());
+        if (c == colors.size())
+        {
+            colors.emplace_back();
+        }
+
+        pointColors[p] = c;
+        colors[c].push_back(p);
+    }
+
+    //
+    // 3. Lay out points color by color
+    //
+
+    IndexRemap optimalPointRemap(points.size());
+    ObjectSimulatorSpecificStructure simulatorSpecificStructure;
+
+    for (auto const & color : colors)
+    {
+        for (ElementIndex p : color)
+        {
+            optimalPointRemap.AddOld(p);
+        }
+
+        simulatorSpecificStructure.PointProcessingBlockSizes.emplace_back(static_cast<ElementCount>(color.size()));
+    }
+
+    LogMessage("GaussSeidelByPointColoringLayoutOptimizer: ", colors.size(), " colors");
+
+    // Springs are only visited via their endpoints, hence their order does not matter
+    return LayoutRemap(
+        std::move(optimalPointRemap),
+        IndexRemap::MakeIdempotent(springs.size()),
+        std::vector<bool>(springs.size(), false),
+        std::move(simulatorSpecificStructure));
+}
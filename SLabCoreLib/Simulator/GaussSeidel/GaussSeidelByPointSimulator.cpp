@@ -10,7 +10,7 @@
 GaussSeidelByPointSimulator::GaussSeidelByPointSimulator(
     Object const & object,
     SimulationParameters const & simulationParameters,
-    ThreadManager const & /*threadManager*/)
+    ThreadManager const & threadManager)
     // Point buffers
     : mPointExternalForceBuffer(object.GetPoints().GetBufferElementCount(), 0, vec2f::zero())
     , mPointIntegrationFactorBuffer(object.GetPoints().GetBufferElementCount(), 0, 0.0f)
@@ -18,15 +18,15 @@ GaussSeidelByPointSimulator::GaussSeidelByPointSimulator(
     , mSpringStiffnessCoefficientBuffer(object.GetSprings().GetBufferElementCount(), 0, 0.0f)
     , mSpringDampingCoefficientBuffer(object.GetSprings().GetBufferElementCount(), 0, 0.0f)
 {
-    CreateState(object, simulationParameters);
+    CreateState(object, simulationParameters, threadManager);
 }
 
 void GaussSeidelByPointSimulator::OnStateChanged(
     Object const & object,
     SimulationParameters const & simulationParameters,
-    ThreadManager const & /*threadManager*/)
+    ThreadManager const & threadManager)
 {
-    CreateState(object, simulationParameters);
+    CreateState(object, simulationParameters, threadManager);
 }
 
 void GaussSeidelByPointSimulator::Update(
@@ -35,13 +35,18 @@ void GaussSeidelByPointSimulator::Update(
     SimulationParameters const & simulationParameters,
     ThreadManager & /*threadManager*/)
 {
+    float const dt = CalculateDt(simulationParameters);
+    float const velocityFactor = CalculateVelocityFactor(simulationParameters);
+
+    ElementCount const pointCount = object.GetPoints().GetElementCount();
+
     for (size_t i = 0; i < simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations; ++i)
     {
         // Integrate external forces and current velocities
-        Integrate(object, simulationParameters);
+        IntegrateRange(object, 0, pointCount, dt, velocityFactor);
 
         // Relax springs - updating positions and velocities
-        RelaxSprings(object, simulationParameters);
+        RelaxSpringsRange(object, 0, pointCount, velocityFactor);
     }
 }
 
@@ -49,9 +54,10 @@ void GaussSeidelByPointSimulator::Update(
 
 void GaussSeidelByPointSimulator::CreateState(
     Object const & object,
-    SimulationParameters const & simulationParameters)
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & /*threadManager*/)
 {
-    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations);
+    float const dt = CalculateDt(simulationParameters);
     float const dtSquared = dt * dt;
 
     //
@@ -108,17 +114,13 @@ void GaussSeidelByPointSimulator::CreateState(
     }
 }
 
-void GaussSeidelByPointSimulator::Integrate(
-    Object & object,
-    SimulationParameters const & simulationParameters)
+float GaussSeidelByPointSimulator::CalculateDt(SimulationParameters const & simulationParameters)
 {
-    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations);
-
-    float * const restrict positionBuffer = reinterpret_cast<float *>(object.GetPoints().GetPositionBuffer());
-    float * const restrict velocityBuffer = reinterpret_cast<float *>(object.GetPoints().GetVelocityBuffer());
-    float const * const restrict externalForceBuffer = reinterpret_cast<float *>(mPointExternalForceBuffer.data());
-    float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data());
+    return simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations);
+}
 
+float GaussSeidelByPointSimulator::CalculateVelocityFactor(SimulationParameters const & simulationParameters)
+{
     float const globalDamping =
         1.0f -
         pow((1.0f - simulationParameters.GaussSeidelCommonSimulator.GlobalDamping),
@@ -126,10 +128,24 @@ void GaussSeidelByPointSimulator::Integrate(
 
     // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
     // provides the final, damped velocity
-    float const velocityFactor = (1.0f - globalDamping) / dt;
+    return (1.0f - globalDamping) / CalculateDt(simulationParameters);
+}
 
-    size_t const count = object.GetPoints().GetBufferElementCount() * 2; // Two components per vector
-    for (size_t i = 0; i < count; ++i)
+void GaussSeidelByPointSimulator::IntegrateRange(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float dt,
+    float velocityFactor)
+{
+    float * const restrict positionBuffer = reinterpret_cast<float *>(object.GetPoints().GetPositionBuffer());
+    float * const restrict velocityBuffer = reinterpret_cast<float *>(object.GetPoints().GetVelocityBuffer());
+    float const * const restrict externalForceBuffer = reinterpret_cast<float *>(mPointExternalForceBuffer.data());
+    float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data());
+
+    size_t const start = startPointIndex * 2; // Two components per vector
+    size_t const end = endPointIndex * 2; // Two components per vector
+    for (size_t i = start; i < end; ++i)
     {
         //
         // Verlet integration (fourth order, with velocity being first order)
@@ -144,21 +160,12 @@ void GaussSeidelByPointSimulator::Integrate(
     }
 }
 
-void GaussSeidelByPointSimulator::RelaxSprings(
+void GaussSeidelByPointSimulator::RelaxSpringsRange(
     Object & object,
-    SimulationParameters const & simulationParameters)
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float velocityFactor)
 {
-    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations);
-
-    float const globalDamping =
-        1.0f -
-        pow((1.0f - simulationParameters.GaussSeidelCommonSimulator.GlobalDamping),
-            12.0f / static_cast<float>(simulationParameters.GaussSeidelCommonSimulator.NumMechanicalDynamicsIterations));
-
-    // Pre-divide damp coefficient by dt to provide the scalar factor which, when multiplied with a displacement,
-    // provides the final, damped velocity
-    float const velocityFactor = (1.0f - globalDamping) / dt;
-
     vec2f * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
     vec2f * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
     float const * const restrict integrationFactorBuffer = reinterpret_cast<float *>(mPointIntegrationFactorBuffer.data());
@@ -167,7 +174,7 @@ void GaussSeidelByPointSimulator::RelaxSprings(
     float const * restrict const stiffnessCoefficientBuffer = mSpringStiffnessCoefficientBuffer.data();
     float const * restrict const dampingCoefficientBuffer = mSpringDampingCoefficientBuffer.data();
 
-    for (auto const pointIndex: object.GetPoints())
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
         vec2f const & thisPointPosition = pointPositionBuffer[pointIndex];
         vec2f const & thisPointVelocity = pointVelocityBuffer[pointIndex];
@@ -44,21 +44,31 @@ public:
         SimulationParameters const & simulationParameters,
         ThreadManager & threadManager) override;
 
-private:
+protected:
 
-    void CreateState(
+    virtual void CreateState(
         Object const & object,
-        SimulationParameters const & simulationParameters);
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    static float CalculateDt(SimulationParameters const & simulationParameters);
+
+    static float CalculateVelocityFactor(SimulationParameters const & simulationParameters);
 
-    void Integrate(
+    void IntegrateRange(
         Object & object,
-        SimulationParameters const & simulationParameters);
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float dt,
+        float velocityFactor);
 
-    void RelaxSprings(
+    virtual void RelaxSpringsRange(
         Object & object,
-        SimulationParameters const & simulationParameters);
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float velocityFactor);
 
-private:
+protected:
 
     //
     // Point buffers
@@ -10,7 +10,7 @@
 PositionBasedBasicSimulator::PositionBasedBasicSimulator(
     Object const & object,
     SimulationParameters const & simulationParameters,
-    ThreadManager const & /*threadManager*/)
+    ThreadManager const & threadManager)
     // Point buffers
     : mPointMassBuffer(object.GetPoints().GetBufferElementCount(), 0, 0.0f)
     , mPointExternalForceBuffer(object.GetPoints().GetBufferElementCount(), 0, vec2f::zero())
@@ -18,15 +18,15 @@ PositionBasedBasicSimulator::PositionBasedBasicSimulator(
     // Spring buffers
     , mSpringScalingFactorsBuffer(object.GetSprings().GetBufferElementCount(), 0, SpringScalingFactors())
 {
-    CreateState(object, simulationParameters);
+    CreateState(object, simulationParameters, threadManager);
 }
 
 void PositionBasedBasicSimulator::OnStateChanged(
     Object const & object,
     SimulationParameters const & simulationParameters,
-    ThreadManager const & /*threadManager*/)
+    ThreadManager const & threadManager)
 {
-    CreateState(object, simulationParameters);
+    CreateState(object, simulationParameters, threadManager);
 }
 
 void PositionBasedBasicSimulator::Update(
@@ -35,16 +35,22 @@ void PositionBasedBasicSimulator::Update(
     SimulationParameters const & simulationParameters,
     ThreadManager & /*threadManager*/)
 {
+    float const dt = CalculateDt(simulationParameters);
+    float const globalDampingCoefficient = CalculateGlobalDampingCoefficient(simulationParameters);
+
+    ElementCount const pointCount = object.GetPoints().GetElementCount();
+    ElementCount const springCount = object.GetSprings().GetElementCount();
+
     for (size_t i = 0; i < simulationParameters.PositionBasedCommonSimulator.NumUpdateIterations; ++i)
     {
-        IntegrateInitialDynamics(object, simulationParameters);
+        IntegrateInitialDynamicsRange(object, 0, pointCount, dt, globalDampingCoefficient);
 
         for (size_t j = 0; j < simulationParameters.PositionBasedCommonSimulator.NumSolverIterations; ++j)
         {
-            ProjectConstraints(object, simulationParameters);
+            ProjectConstraintsRange(object, 0, springCount);
         }
 
-        FinalizeDynamics(object, simulationParameters);
+        FinalizeDynamicsRange(object, 0, pointCount, dt);
     }
 }
 
@@ -52,7 +58,8 @@ void PositionBasedBasicSimulator::Update(
 
 void PositionBasedBasicSimulator::CreateState(
     Object const & object,
-    SimulationParameters const & simulationParameters)
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & /*threadManager*/)
 {
     //
     // Initialize point buffers
@@ -91,14 +98,23 @@ void PositionBasedBasicSimulator::CreateState(
     }
 }
 
-void PositionBasedBasicSimulator::IntegrateInitialDynamics(
-    Object & object,
-    SimulationParameters const & simulationParameters)
+float PositionBasedBasicSimulator::CalculateDt(SimulationParameters const & simulationParameters)
 {
-    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.PositionBasedCommonSimulator.NumUpdateIterations);
+    return simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.PositionBasedCommonSimulator.NumUpdateIterations);
+}
 
-    float const globalDampingCoefficient = 1.0f - pow((1.0f - simulationParameters.PositionBasedCommonSimulator.GlobalDamping), 0.4f);
+float PositionBasedBasicSimulator::CalculateGlobalDampingCoefficient(SimulationParameters const & simulationParameters)
+{
+    return 1.0f - pow((1.0f - simulationParameters.PositionBasedCommonSimulator.GlobalDamping), 0.4f);
+}
 
+void PositionBasedBasicSimulator::IntegrateInitialDynamicsRange(
+    Object & object,
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float dt,
+    float globalDampingCoefficient)
+{
     vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
     vec2f * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
     float const * restrict const pointMassBuffer = mPointMassBuffer.data();
@@ -106,7 +122,7 @@ void PositionBasedBasicSimulator::IntegrateInitialDynamics(
     vec2f const * restrict const pointExternalForceBuffer = mPointExternalForceBuffer.data();
     vec2f * restrict const pointPositionPredictionBuffer = mPointPositionPredictionBuffer.data();
 
-    for (ElementIndex p : object.GetPoints())
+    for (ElementIndex p = startPointIndex; p < endPointIndex; ++p)
     {
         pointVelocityBuffer[p] =
             (pointVelocityBuffer[p] + pointExternalForceBuffer[p] * dt / pointMassBuffer[p] * pointFrozenCoefficientBuffer[p])
@@ -116,19 +132,18 @@ void PositionBasedBasicSimulator::IntegrateInitialDynamics(
     }
 }
 
-void PositionBasedBasicSimulator::ProjectConstraints(
+void PositionBasedBasicSimulator::ProjectConstraintsRange(
     Object const & object,
-    SimulationParameters const & /*simulationParameters*/)
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
 {
-    vec2f const * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
-    float const * restrict const pointMassBuffer = mPointMassBuffer.data();
     vec2f * restrict const pointPositionPredictionBuffer = mPointPositionPredictionBuffer.data();
 
     Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
     float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
     SpringScalingFactors const * restrict const springScalingFactorsBuffer = mSpringScalingFactorsBuffer.data();
 
-    for (ElementIndex s : object.GetSprings())
+    for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
     {
         auto const endpointAIndex = endpointsBuffer[s].PointAIndex;
         auto const endpointBIndex = endpointsBuffer[s].PointBIndex;
@@ -147,17 +162,17 @@ void PositionBasedBasicSimulator::ProjectConstraints(
     }
 }
 
-void PositionBasedBasicSimulator::FinalizeDynamics(
+void PositionBasedBasicSimulator::FinalizeDynamicsRange(
     Object & object,
-    SimulationParameters const & simulationParameters)
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    float dt)
 {
-    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(simulationParameters.PositionBasedCommonSimulator.NumUpdateIterations);
-
     vec2f * restrict const pointPositionBuffer = object.GetPoints().GetPositionBuffer();
     vec2f * restrict const pointVelocityBuffer = object.GetPoints().GetVelocityBuffer();
     vec2f const * restrict const pointPositionPredictionBuffer = mPointPositionPredictionBuffer.data();
 
-    for (ElementIndex p : object.GetPoints())
+    for (ElementIndex p = startPointIndex; p < endPointIndex; ++p)
     {
         pointVelocityBuffer[p] = (pointPositionPredictionBuffer[p] - pointPositionBuffer[p]) / dt;
         pointPositionBuffer[p] = pointPositionPredictionBuffer[p];
@@ -14,7 +14,7 @@
  * Basic, naive implementation of a mass-spring-damper system, based on Position-Based Dynamics
  * from Muller (https://matthias-research.github.io/pages/publications/posBasedDyn.pdf).
  */
-class PositionBasedBasicSimulator final : public ISimulator
+class PositionBasedBasicSimulator : public ISimulator
 {
 public:
 
@@ -45,25 +45,36 @@ public:
         SimulationParameters const & simulationParameters,
         ThreadManager & threadManager) override;
 
-private:
+protected:
 
-    void CreateState(
+    virtual void CreateState(
         Object const & object,
-        SimulationParameters const & simulationParameters);
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    static float CalculateDt(SimulationParameters const & simulationParameters);
+
+    static float CalculateGlobalDampingCoefficient(SimulationParameters const & simulationParameters);
 
-    void IntegrateInitialDynamics(
+    void IntegrateInitialDynamicsRange(
         Object & object,
-        SimulationParameters const & simulationParameters);
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float dt,
+        float globalDampingCoefficient);
 
-    void ProjectConstraints(
+    void ProjectConstraintsRange(
         Object const & object,
-        SimulationParameters const & simulationParameters);
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex); // Excluded
 
-    void FinalizeDynamics(
+    void FinalizeDynamicsRange(
         Object & object,
-        SimulationParameters const & simulationParameters);
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex, // Excluded
+        float dt);
 
-private:
+protected:
 
     //
     // Point buffers
@@ -9,6 +9,7 @@ PositionBasedCommonSimulatorParameters::PositionBasedCommonSimulatorParameters()
     : NumUpdateIterations(1)
     , NumSolverIterations(1)
     , SpringStiffness(1.0f)
+    , XPBDSpringStiffnessCoefficient(36700.0f)
     , GlobalDamping(0.99983998f)
 {
 }
\ No newline at end of file
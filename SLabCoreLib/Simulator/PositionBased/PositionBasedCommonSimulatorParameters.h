@@ -24,6 +24,12 @@ struct PositionBasedCommonSimulatorParameters
     static float constexpr MinSpringStiffness = 0.0f;
     static float constexpr MaxSpringStiffness = 1.0f;
 
+    // The springs' stiffness for XPBD, whose compliance is the inverse of this coefficient
+    // times the material stiffness
+    float XPBDSpringStiffnessCoefficient;
+    static float constexpr MinXPBDSpringStiffnessCoefficient = 0.0f;
+    static float constexpr MaxXPBDSpringStiffnessCoefficient = 4000000.0f;
+
     // Global velocity damping; lowers velocity uniformly, damping oscillations.
     float GlobalDamping;
     static float constexpr MinGlobalDamping = 0.0f;
@@ -0,0 +1,403 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "PositionBasedMTColoredSimulator.h"
+
+#include "Log.h"
+#include "SysSpecifics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+/*
+ * An update is one single ThreadPool batch, in which each thread runs all the
+ * update iterations:
+ *
+ *  for each update iteration:
+ *      integrate initial dynamics of own points
+ *      -- barrier --
+ *      for each solver iteration:
+ *          for each color:
+ *              project own springs of this color
+ *              -- barrier --
+ *      finalize dynamics of own points
+ *
+ * Finalization and the next integration only touch a thread's own points,
+ * hence they need no barrier in between.
+ */
+
+PositionBasedMTColoredSimulator::PositionBasedMTColoredSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : PositionBasedBasicSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+    , mThreadStates()
+    , mParallelRegionTasks()
+    , mPhaseBarrier()
+    , mCurrentObject(nullptr)
+    , mNumUpdateIterations(0)
+    , mNumSolverIterations(0)
+    , mDt(0.0f)
+    , mGlobalDampingCoefficient(0.0f)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void PositionBasedMTColoredSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & threadManager)
+{
+    //
+    // Calculate parameters for this update
+    //
+
+    mNumUpdateIterations = simulationParameters.PositionBasedCommonSimulator.NumUpdateIterations;
+    mNumSolverIterations = simulationParameters.PositionBasedCommonSimulator.NumSolverIterations;
+    mDt = CalculateDt(simulationParameters);
+    mGlobalDampingCoefficient = CalculateGlobalDampingCoefficient(simulationParameters);
+
+    //
+    // Run parallel region
+    //
+
+    mCurrentObject = &object;
+
+    threadManager.GetSimulationThreadPool().Run(mParallelRegionTasks);
+
+    mCurrentObject = nullptr;
+}
+
+void PositionBasedMTColoredSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    PositionBasedBasicSimulator::CreateState(object, simulationParameters, threadManager);
+
+    // Clear threading state
+    mThreadStates.clear();
+    mParallelRegionTasks.clear();
+
+    // Number of 4-spring blocks per thread, assuming we use all parallelism
+    ElementCount const numberOfSprings = static_cast<ElementCount>(object.GetSprings().GetElementCount());
+    ElementCount const numberOfFourSpringsPerThread = numberOfSprings / (static_cast<ElementCount>(threadManager.GetSimulationParallelism()) * 4);
+
+    size_t parallelism;
+    if (numberOfFourSpringsPerThread > 0)
+    {
+        parallelism = threadManager.GetSimulationParallelism();
+    }
+    else
+    {
+        // Not enough, use just one thread
+        parallelism = 1;
+    }
+
+    // Number of points per thread, rounded to a couple of cache lines
+    // so that threads don't share cache lines while integrating
+    ElementCount constexpr PointGranularity = 16;
+    ElementCount const numberOfPoints = static_cast<ElementCount>(object.GetPoints().GetElementCount());
+    ElementCount const numberOfPointsPerThread =
+        (numberOfPoints / static_cast<ElementCount>(parallelism) + PointGranularity - 1) / PointGranularity * PointGranularity;
+
+    ElementIndex pointStart = 0;
+    for (size_t t = 0; t < parallelism; ++t)
+    {
+        ElementIndex const pointEnd = (t < parallelism - 1)
+            ? std::min(pointStart + numberOfPointsPerThread, numberOfPoints)
+            : numberOfPoints;
+
+        mThreadStates.emplace_back(pointStart, pointEnd);
+
+        mParallelRegionTasks.emplace_back(
+            [this, t]()
+            {
+                assert(mCurrentObject != nullptr);
+
+                RunParallelRegion(
+                    *mCurrentObject,
+                    t);
+            });
+
+        pointStart = pointEnd;
+    }
+
+    //
+    // Split each color among threads, in units of four springs; the last
+    // thread also takes the color's few trailing springs
+    //
+
+    auto const & springBlockSizes = object.GetSimulatorSpecificStructure().SpringProcessingBlockSizes;
+
+    ElementIndex colorStart = 0;
+    for (ElementCount const colorSpringCount : springBlockSizes)
+    {
+        ElementIndex const colorEnd = colorStart + colorSpringCount;
+
+        ElementCount const numberOfUnits = colorSpringCount / 4;
+
+        for (size_t t = 0; t < parallelism; ++t)
+        {
+            ElementIndex const unitStart = static_cast<ElementIndex>(numberOfUnits * t / parallelism);
+            ElementIndex const unitEnd = static_cast<ElementIndex>(numberOfUnits * (t + 1) / parallelism);
+
+            mThreadStates[t].ColorSpringRanges.emplace_back(
+                colorStart + unitStart * 4,
+                (t < parallelism - 1) ? colorStart + unitEnd * 4 : colorEnd);
+        }
+
+        colorStart = colorEnd;
+    }
+
+    assert(colorStart == numberOfSprings);
+
+    mPhaseBarrier.Reset(parallelism);
+
+    LogMessage("PositionBasedMTColoredSimulator: numSprings=", numberOfSprings, " numColors=", springBlockSizes.size(),
+        " numberOfPointsPerThread=", numberOfPointsPerThread, " numThreads=", parallelism);
+}
+
+void PositionBasedMTColoredSimulator::RunParallelRegion(
+    Object & object,
+    size_t threadIndex)
+{
+    ThreadState const & threadState = mThreadStates[threadIndex];
+
+    for (size_t i = 0; i < mNumUpdateIterations; ++i)
+    {
+        IntegrateInitialDynamicsRange(
+            object,
+            threadState.PointRange.StartIndex,
+            threadState.PointRange.EndIndex,
+            mDt,
+            mGlobalDampingCoefficient);
+
+        // Wait for all predictions to be in
+        mPhaseBarrier.ArriveAndWait();
+
+        for (size_t j = 0; j < mNumSolverIterations; ++j)
+        {
+            for (ElementRange const & springRange : threadState.ColorSpringRanges)
+            {
+                ProjectConstraintsRangeVectorized(
+                    object,
+                    springRange.StartIndex,
+                    springRange.EndIndex);
+
+                // Wait for all springs of this color to be projected
+                mPhaseBarrier.ArriveAndWait();
+            }
+        }
+
+        FinalizeDynamicsRange(
+            object,
+            threadState.PointRange.StartIndex,
+            threadState.PointRange.EndIndex,
+            mDt);
+    }
+}
+
+void PositionBasedMTColoredSimulator::ProjectConstraintsRangeVectorized(
+    Object const & object,
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
+{
+#if !FS_IS_ARCHITECTURE_X86_32() && !FS_IS_ARCHITECTURE_X86_64()
+#error Unsupported Architecture
+#endif
+
+    vec2f * restrict const pointPositionPredictionBuffer = mPointPositionPredictionBuffer.data();
+
+    Springs::Endpoints const * restrict const endpointsBuffer = object.GetSprings().GetEndpointsBuffer();
+    float const * restrict const restLengthBuffer = object.GetSprings().GetRestLengthBuffer();
+    SpringScalingFactors const * restrict const springScalingFactorsBuffer = mSpringScalingFactorsBuffer.data();
+
+    static_assert(sizeof(SpringScalingFactors) == 2 * sizeof(float));
+
+    __m128 const Zero = _mm_setzero_ps();
+
+    aligned_to_vword vec2f tmpDeltaPredictedPosA[4];
+    aligned_to_vword vec2f tmpDeltaPredictedPosB[4];
+
+    //
+    // 1. Four by four; springs of one color share no endpoints, hence
+    //    we may update all eight endpoints independently
+    //
+
+    ElementIndex const endSpringIndexVectorized = startSpringIndex + (endSpringIndex - startSpringIndex) / 4 * 4;
+
+    ElementIndex s = startSpringIndex;
+
+    for (; s < endSpringIndexVectorized; s += 4)
+    {
+        // s0_displacement.x, s0_displacement.y, s1_displacement.x, s1_displacement.y
+        __m128 const s0s1_displacement_xy = _mm_sub_ps(
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionPredictionBuffer + endpointsBuffer[s + 0].PointAIndex))),
+                reinterpret_cast<__m64 const *>(pointPositionPredictionBuffer + endpointsBuffer[s + 1].PointAIndex)),
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionPredictionBuffer + endpointsBuffer[s + 0].PointBIndex))),
+                reinterpret_cast<__m64 const *>(pointPositionPredictionBuffer + endpointsBuffer[s + 1].PointBIndex)));
+
+        // s2_displacement.x, s2_displacement.y, s3_displacement.x, s3_displacement.y
+        __m128 const s2s3_displacement_xy = _mm_sub_ps(
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionPredictionBuffer + endpointsBuffer[s + 2].PointAIndex))),
+                reinterpret_cast<__m64 const *>(pointPositionPredictionBuffer + endpointsBuffer[s + 3].PointAIndex)),
+            _mm_loadh_pi(
+                _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const * restrict>(pointPositionPredictionBuffer + endpointsBuffer[s + 2].PointBIndex))),
+                reinterpret_cast<__m64 const *>(pointPositionPredictionBuffer + endpointsBuffer[s + 3].PointBIndex)));
+
+        // Shuffle displacements
+        __m128 const s0s1s2s3_displacement_x = _mm_shuffle_ps(s0s1_displacement_xy, s2s3_displacement_xy, 0x88);
+        __m128 const s0s1s2s3_displacement_y = _mm_shuffle_ps(s0s1_displacement_xy, s2s3_displacement_xy, 0xDD);
+
+        // float const displacementLength = displacement.length();
+        __m128 const s0s1s2s3_displacementLength = _mm_sqrt_ps(
+            _mm_add_ps(
+                _mm_mul_ps(s0s1s2s3_displacement_x, s0s1s2s3_displacement_x),
+                _mm_mul_ps(s0s1s2s3_displacement_y, s0s1s2s3_displacement_y)));
+
+        // vec2f const springDir = displacement.normalise(displacementLength);
+        __m128 const validMask = _mm_cmpgt_ps(s0s1s2s3_displacementLength, Zero);
+        __m128 const s0s1s2s3_sdir_x = _mm_and_ps(
+            _mm_div_ps(s0s1s2s3_displacement_x, s0s1s2s3_displacementLength),
+            validMask);
+        __m128 const s0s1s2s3_sdir_y = _mm_and_ps(
+            _mm_div_ps(s0s1s2s3_displacement_y, s0s1s2s3_displacementLength),
+            validMask);
+
+        // float const strain = displacementLength - restLengthBuffer[s];
+        __m128 const s0s1s2s3_strain = _mm_sub_ps(
+            s0s1s2s3_displacementLength,
+            _mm_loadu_ps(restLengthBuffer + s));
+
+        // Scaling factors: s0.A, s0.B, s1.A, s1.B | s2.A, s2.B, s3.A, s3.B
+        __m128 const s0s1_scalingFactors = _mm_loadu_ps(reinterpret_cast<float const *>(springScalingFactorsBuffer + s));
+        __m128 const s2s3_scalingFactors = _mm_loadu_ps(reinterpret_cast<float const *>(springScalingFactorsBuffer + s + 2));
+
+        // strain * EndpointA, strain * EndpointB
+        __m128 const s0s1s2s3_strainA = _mm_mul_ps(
+            s0s1s2s3_strain,
+            _mm_shuffle_ps(s0s1_scalingFactors, s2s3_scalingFactors, 0x88));
+        __m128 const s0s1s2s3_strainB = _mm_mul_ps(
+            s0s1s2s3_strain,
+            _mm_shuffle_ps(s0s1_scalingFactors, s2s3_scalingFactors, 0xDD));
+
+        // vec2f const deltaPredictedPosA = -springDir * springScalingFactorsBuffer[s].EndpointA * strain;
+        // vec2f const deltaPredictedPosB = springDir * springScalingFactorsBuffer[s].EndpointB * strain;
+        __m128 const s0s1s2s3_deltaA_x = _mm_sub_ps(Zero, _mm_mul_ps(s0s1s2s3_sdir_x, s0s1s2s3_strainA));
+        __m128 const s0s1s2s3_deltaA_y = _mm_sub_ps(Zero, _mm_mul_ps(s0s1s2s3_sdir_y, s0s1s2s3_strainA));
+        __m128 const s0s1s2s3_deltaB_x = _mm_mul_ps(s0s1s2s3_sdir_x, s0s1s2s3_strainB);
+        __m128 const s0s1s2s3_deltaB_y = _mm_mul_ps(s0s1s2s3_sdir_y, s0s1s2s3_strainB);
+
+        //
+        // Unpack and apply deltas:
+        //      pointPositionPredictionBuffer[endpointAIndex] += deltaPredictedPosA;
+        //      pointPositionPredictionBuffer[endpointBIndex] += deltaPredictedPosB;
+        //
+
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpDeltaPredictedPosA[0])), _mm_unpacklo_ps(s0s1s2s3_deltaA_x, s0s1s2s3_deltaA_y));
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpDeltaPredictedPosA[2])), _mm_unpackhi_ps(s0s1s2s3_deltaA_x, s0s1s2s3_deltaA_y));
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpDeltaPredictedPosB[0])), _mm_unpacklo_ps(s0s1s2s3_deltaB_x, s0s1s2s3_deltaB_y));
+        _mm_store_ps(reinterpret_cast<float *>(&(tmpDeltaPredictedPosB[2])), _mm_unpackhi_ps(s0s1s2s3_deltaB_x, s0s1s2s3_deltaB_y));
+
+        pointPositionPredictionBuffer[endpointsBuffer[s + 0].PointAIndex] += tmpDeltaPredictedPosA[0];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 0].PointBIndex] += tmpDeltaPredictedPosB[0];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 1].PointAIndex] += tmpDeltaPredictedPosA[1];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 1].PointBIndex] += tmpDeltaPredictedPosB[1];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 2].PointAIndex] += tmpDeltaPredictedPosA[2];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 2].PointBIndex] += tmpDeltaPredictedPosB[2];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 3].PointAIndex] += tmpDeltaPredictedPosA[3];
+        pointPositionPredictionBuffer[endpointsBuffer[s + 3].PointBIndex] += tmpDeltaPredictedPosB[3];
+    }
+
+    //
+    // 2. One-by-one
+    //
+
+    ProjectConstraintsRange(
+        object,
+        s,
+        endSpringIndex);
+}
+
+/////////////////////////////////////////////////
+
+ILayoutOptimizer::LayoutRemap PositionBasedColoringLayoutOptimizer::Remap(
+    ObjectBuildPointIndexMatrix const & /*pointMatrix*/,
+    std::vector<ObjectBuildPoint> const & points,
+    std::vector<ObjectBuildSpring> const & springs) const
+{
+    //
+    // 1. Greedily color springs, so that no two springs of the same color
+    //    share an endpoint
+    //
+
+    // Bitmask of the colors already taken by the springs at each point;
+    // greedy coloring uses at most 2 * (max springs per point) - 1 colors
+    static_assert(2 * SimulationParameters::MaxSpringsPerPoint - 1 <= 32);
+    std::vector<std::uint32_t> pointColorMasks(points.size(), 0);
+
+    std::vector<std::vector<ElementIndex>> colors;
+
+    for (ElementIndex s = 0; s < springs.size(); ++s)
+    {
+        std::uint32_t const takenMask =
+            pointColorMasks[springs[s].PointAIndex]
+            | pointColorMasks[springs[s].PointBIndex];
+
+        size_t c = 0;
+        while ((takenMask & (1u << c)) != 0)
+        {
+            ++c;
+        }
+
+        assert(c < 32);
+
+        if (c == colors.size())
+        {
+            colors.emplace_back();
+        }
+
+        colors[c].push_back(s);
+
+        pointColorMasks[springs[s].PointAIndex] |= (1u << c);
+        pointColorMasks[springs[s].PointBIndex] |= (1u << c);
+    }
+
+    //
+    // 2. Lay out springs color by color
+    //
+
+    IndexRemap optimalSpringRemap(springs.size());
+    ObjectSimulatorSpecificStructure simulatorSpecificStructure;
+
+    for (auto const & color : colors)
+    {
+        for (ElementIndex s : color)
+        {
+            optimalSpringRemap.AddOld(s);
+        }
+
+        simulatorSpecificStructure.SpringProcessingBlockSizes.emplace_back(static_cast<ElementCount>(color.size()));
+    }
+
+    LogMessage("PositionBasedColoringLayoutOptimizer: ", colors.size(), " colors");
+
+    // Points stay as they are
+    return LayoutRemap(
+        IndexRemap::MakeIdempotent(points.size()),
+        std::move(optimalSpringRemap),
+        std::vector<bool>(springs.size(), false),
+        std::move(simulatorSpecificStructure));
+}
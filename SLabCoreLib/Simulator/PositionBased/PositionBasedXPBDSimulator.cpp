@@ -0,0 +1,108 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "PositionBasedXPBDSimulator.h"
+
+#include <cassert>
+#include <cmath>
+
+/*
+ * With one single pass per substep, the Lagrange multiplier of each spring starts
+ * from zero at each projection, and the XPBD update reduces to:
+ *
+ *      deltaLambda = -C / (wA + wB + alpha / h^2)
+ *
+ * with alpha = 1 / k being the compliance; the displacement of each endpoint is thus
+ * the same as in PBD, with - for endpoint A - a scaling factor of:
+ *
+ *      wA / (wA + wB + 1 / (k * h^2)) = k * h^2 * wA / (k * h^2 * (wA + wB) + 1)
+ *
+ * The latter form also copes with zero stiffness and with frozen endpoints.
+ * We may then re-use the PBD projection, only with different scaling factors.
+ */
+
+PositionBasedXPBDSimulator::PositionBasedXPBDSimulator(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+    : PositionBasedBasicSimulator(
+        object,
+        simulationParameters,
+        threadManager)
+{
+    // CreateState() on base has been called; our turn now
+    CreateState(object, simulationParameters, threadManager);
+}
+
+void PositionBasedXPBDSimulator::Update(
+    Object & object,
+    float /*currentSimulationTime*/,
+    SimulationParameters const & simulationParameters,
+    ThreadManager & /*threadManager*/)
+{
+    size_t const numSubsteps = CalculateNumSubsteps(simulationParameters);
+
+    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(numSubsteps);
+
+    // Spread the damping of each update iteration among its substeps
+    float const globalDampingCoefficient = std::pow(
+        CalculateGlobalDampingCoefficient(simulationParameters),
+        1.0f / static_cast<float>(simulationParameters.PositionBasedCommonSimulator.NumSolverIterations));
+
+    ElementCount const pointCount = object.GetPoints().GetElementCount();
+    ElementCount const springCount = object.GetSprings().GetElementCount();
+
+    for (size_t i = 0; i < numSubsteps; ++i)
+    {
+        IntegrateInitialDynamicsRange(object, 0, pointCount, dt, globalDampingCoefficient);
+
+        ProjectConstraintsRange(object, 0, springCount);
+
+        FinalizeDynamicsRange(object, 0, pointCount, dt);
+    }
+}
+
+void PositionBasedXPBDSimulator::CreateState(
+    Object const & object,
+    SimulationParameters const & simulationParameters,
+    ThreadManager const & threadManager)
+{
+    PositionBasedBasicSimulator::CreateState(object, simulationParameters, threadManager);
+
+    float const dt = simulationParameters.Common.SimulationTimeStepDuration / static_cast<float>(CalculateNumSubsteps(simulationParameters));
+    float const dtSquared = dt * dt;
+
+    //
+    // Re-initialize spring scaling factors
+    //
+
+    Points const & points = object.GetPoints();
+    Springs const & springs = object.GetSprings();
+
+    for (auto springIndex : springs)
+    {
+        auto const endpointAIndex = springs.GetEndpointAIndex(springIndex);
+        auto const endpointBIndex = springs.GetEndpointBIndex(springIndex);
+
+        float const endpointAMassInv = (1.0f / mPointMassBuffer[endpointAIndex]) * points.GetFrozenCoefficient(endpointAIndex);
+        float const endpointBMassInv = (1.0f / mPointMassBuffer[endpointBIndex]) * points.GetFrozenCoefficient(endpointBIndex);
+
+        // k * h^2, i.e. the inverse of the time-step-scaled compliance
+        float const stiffnessDtSquared =
+            simulationParameters.PositionBasedCommonSimulator.XPBDSpringStiffnessCoefficient
+            * springs.GetMaterialStiffness(springIndex)
+            * dtSquared;
+
+        float const den = stiffnessDtSquared * (endpointAMassInv + endpointBMassInv) + 1.0f;
+        mSpringScalingFactorsBuffer[springIndex].EndpointA = stiffnessDtSquared * endpointAMassInv / den;
+        mSpringScalingFactorsBuffer[springIndex].EndpointB = stiffnessDtSquared * endpointBMassInv / den;
+    }
+}
+
+size_t PositionBasedXPBDSimulator::CalculateNumSubsteps(SimulationParameters const & simulationParameters)
+{
+    return simulationParameters.PositionBasedCommonSimulator.NumUpdateIterations
+        * simulationParameters.PositionBasedCommonSimulator.NumSolverIterations;
+}
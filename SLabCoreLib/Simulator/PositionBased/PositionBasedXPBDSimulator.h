@@ -0,0 +1,57 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "PositionBasedBasicSimulator.h"
+
+#include "Simulator/Common/ISimulator.h"
+
+#include <memory>
+#include <string>
+
+/*
+ * Extended Position-Based Dynamics from Macklin et al. (https://matthias-research.github.io/pages/publications/XPBD.pdf),
+ * with the "small steps" scheme (https://mmacklin.com/smallsteps.pdf): many substeps, each with
+ * one single constraint projection pass.
+ *
+ * Springs have a compliance - the inverse of their stiffness - derived from their material's
+ * stiffness, hence their effective stiffness does not depend on the number of passes.
+ *
+ * The number of substeps is the product of the number of update iterations and of the number
+ * of solver iterations, so that for the same settings the cost per step is the same as
+ * in the "Basic" simulator.
+ */
+class PositionBasedXPBDSimulator final : public PositionBasedBasicSimulator
+{
+public:
+
+    static std::string GetSimulatorName()
+    {
+        return "Position Based - XPBD";
+    }
+
+public:
+
+    PositionBasedXPBDSimulator(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager);
+
+    void Update(
+        Object & object,
+        float currentSimulationTime,
+        SimulationParameters const & simulationParameters,
+        ThreadManager & threadManager) override;
+
+private:
+
+    void CreateState(
+        Object const & object,
+        SimulationParameters const & simulationParameters,
+        ThreadManager const & threadManager) override;
+
+    static size_t CalculateNumSubsteps(SimulationParameters const & simulationParameters);
+};
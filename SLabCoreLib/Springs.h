@@ -125,6 +125,11 @@ public:
         return mMaterialStiffnessBuffer[springElementIndex];
     }
 
+    float const * restrict GetMaterialStiffnessBuffer() const noexcept
+    {
+        return mMaterialStiffnessBuffer.data();
+    }
+
     float GetLength(
         ElementIndex springElementIndex,
         Points const & points) const
@@ -153,11 +158,21 @@ public:
         return mRenderColorBuffer[springElementIndex];
     }
 
+    vec4f const * GetRenderColorBuffer() const
+    {
+        return mRenderColorBuffer.data();
+    }
+
     float GetRenderNormThickness(ElementIndex springElementIndex) const
     {
         return mRenderNormThicknessBuffer[springElementIndex];
     }
 
+    float const * GetRenderNormThicknessBuffer() const
+    {
+        return mRenderNormThicknessBuffer.data();
+    }
+
     float GetRenderHighlight(ElementIndex springElementIndex) const
     {
         return mRenderHighlightBuffer[springElementIndex];
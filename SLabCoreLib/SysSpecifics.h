@@ -147,6 +147,110 @@ inline constexpr T ceil_square_power_of_two(T value)
 #include <pmmintrin.h>
 #endif
 
+#if (FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()) && defined(_MSC_VER)
+#include <intrin.h>
+#elif (FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32())
+#include <cpuid.h>
+#endif
+
+/*
+ * Marks a function as using AVX2 and FMA instructions, which are not enabled
+ * for the whole build; such functions may only be invoked after having checked
+ * is_avx2_fma_supported() at runtime.
+ *
+ * MSVC does not need this, as it allows any intrinsic in any function.
+ */
+#if (FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()) && (defined(__GNUC__) || defined(__clang__))
+#define FS_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+#define FS_TARGET_AVX2_FMA
+#endif
+
+/*
+ * Marks a function as using F16C (half-float conversion) instructions; as above,
+ * such functions may only be invoked after having checked is_f16c_supported().
+ */
+#if (FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()) && (defined(__GNUC__) || defined(__clang__))
+#define FS_TARGET_F16C __attribute__((target("f16c")))
+#else
+#define FS_TARGET_F16C
+#endif
+
+/*
+ * Checks whether the CPU - and the OS - support AVX2 and FMA.
+ */
+inline bool is_avx2_fma_supported() noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7)
+        return false;
+
+    __cpuid(cpuInfo, 1);
+    bool const isFMA = (cpuInfo[2] & (1 << 12)) != 0;
+    bool const isOSXSAVE = (cpuInfo[2] & (1 << 27)) != 0;
+    bool const isAVX = (cpuInfo[2] & (1 << 28)) != 0;
+    if (!isFMA || !isOSXSAVE || !isAVX)
+        return false;
+
+    // Check that the OS saves YMM registers
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 5)) != 0; // AVX2
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+#else
+    return false;
+#endif
+}
+
+/*
+ * Checks whether the CPU - and the OS - support F16C.
+ */
+inline bool is_f16c_supported() noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+
+    __cpuid(cpuInfo, 1);
+    bool const isOSXSAVE = (cpuInfo[2] & (1 << 27)) != 0;
+    bool const isAVX = (cpuInfo[2] & (1 << 28)) != 0;
+    bool const isF16C = (cpuInfo[2] & (1 << 29)) != 0;
+    if (!isOSXSAVE || !isAVX || !isF16C)
+        return false;
+
+    // F16C instructions are VEX-encoded, hence the OS must save YMM registers
+    return (_xgetbv(0) & 0x6) == 0x6;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    // F16C instructions are VEX-encoded, hence we also need AVX to be usable
+    return (ecx & bit_F16C) != 0 && __builtin_cpu_supports("avx");
+#endif
+#else
+    return false;
+#endif
+}
+
+/*
+ * Hints the processor that we're in a spin-wait loop.
+ */
+inline void spin_wait_pause() noexcept
+{
+#if FS_IS_ARCHITECTURE_X86_64() || FS_IS_ARCHITECTURE_X86_32()
+    _mm_pause();
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Alignment
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,84 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "SysSpecifics.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+
+/*
+ * A reusable barrier for a fixed number of threads, meant for synchronizing
+ * phases of tasks running in the same ThreadPool batch (see ThreadPool::Run()
+ * for why that is safe).
+ *
+ * Waiters spin for a while, and then start yielding, as the barrier is
+ * expected to be crossed quickly but we don't want to starve threads
+ * when the machine is oversubscribed.
+ */
+class ThreadBarrier final
+{
+public:
+
+    explicit ThreadBarrier(size_t threadCount = 1)
+        : mThreadCount(threadCount)
+        , mArrivedCount(0)
+        , mGeneration(0)
+    {
+        assert(threadCount > 0);
+    }
+
+    ThreadBarrier(ThreadBarrier const &) = delete;
+    ThreadBarrier & operator=(ThreadBarrier const &) = delete;
+
+    /*
+     * May only be invoked while no threads are waiting.
+     */
+    void Reset(size_t threadCount)
+    {
+        assert(threadCount > 0);
+        assert(mArrivedCount.load() == 0);
+
+        mThreadCount = threadCount;
+    }
+
+    size_t GetThreadCount() const
+    {
+        return mThreadCount;
+    }
+
+    void ArriveAndWait()
+    {
+        std::uint32_t const generation = mGeneration.load(std::memory_order_acquire);
+
+        if (mArrivedCount.fetch_add(1, std::memory_order_acq_rel) + 1 == mThreadCount)
+        {
+            // Last one in: release everyone
+            mArrivedCount.store(0, std::memory_order_relaxed);
+            mGeneration.fetch_add(1, std::memory_order_acq_rel);
+        }
+        else
+        {
+            for (size_t i = 0; mGeneration.load(std::memory_order_acquire) == generation; ++i)
+            {
+                if (i < SpinBudget)
+                    spin_wait_pause();
+                else
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+
+    static size_t constexpr SpinBudget = 4096;
+
+    size_t mThreadCount;
+    std::atomic<size_t> mArrivedCount;
+    std::atomic<std::uint32_t> mGeneration;
+};
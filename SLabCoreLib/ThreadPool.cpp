@@ -18,13 +18,21 @@
 
 ThreadPool::ThreadPool(
     size_t parallelism,
-    ThreadManager & threadManager)
-    : mLock()
-    , mThreads()
+    ThreadManager & threadManager,
+    size_t spinBudget)
+    : mThreads()
+    , mCurrentTasks(nullptr)
+    , mNextTaskIndex(0)
+    , mTasksToComplete(0)
+    , mEpoch(0)
+    , mIsBatchRunning(false)
+    , mActiveWorkers(0)
+    , mSpinBudget(spinBudget)
+    , mLock()
     , mWorkerThreadSignal()
     , mMainThreadSignal()
-    , mRemainingTasks()
-    , mTasksToComplete(0)
+    , mParkedWorkers(0)
+    , mIsMainThreadParked(false)
     , mIsStop(false)
 {
     assert(parallelism > 0);
@@ -60,55 +68,93 @@ ThreadPool::~ThreadPool()
 
 void ThreadPool::Run(std::vector<Task> const & tasks)
 {
-    assert(mRemainingTasks.empty());
     assert(0 == mTasksToComplete);
+    assert(0 == mActiveWorkers);
+    assert(tasks.size() <= GetParallelism());
 
-    // Queue all the tasks except the first one,
-    // which we're gonna run immediately now to guarantee
-    // that the first task always runs on the main thread
+    if (tasks.empty())
     {
-        std::unique_lock const lock{ mLock };
+        return;
+    }
 
-        for (size_t t = 1; t < tasks.size(); ++t)
+    if (tasks.size() == 1 || mThreads.empty())
+    {
+        // Nothing to fork
+        for (auto const & task : tasks)
         {
-            mRemainingTasks.push_back(&(tasks[t]));
+            RunTask(task);
         }
 
-        mTasksToComplete = mRemainingTasks.size();
+        return;
     }
 
-    // Signal threads
-    mWorkerThreadSignal.notify_all();
+    //
+    // Publish batch
+    //
 
-    // Run the first task on the main thread
-    if (!tasks.empty())
+    mCurrentTasks = &tasks;
+    mNextTaskIndex.store(1, std::memory_order_relaxed); // First task is ours
+    mTasksToComplete.store(tasks.size() - 1, std::memory_order_relaxed);
+    mIsBatchRunning.store(true);
+    mEpoch.fetch_add(1); // Releases all of the above
+
+    // Wake up parked workers, if any
+    if (mParkedWorkers.load() > 0)
     {
-        RunTask(tasks.front());
+        {
+            // Taking the lock guarantees that workers are either waiting,
+            // or have yet to check the epoch
+            std::unique_lock const lock{ mLock };
+        }
+
+        mWorkerThreadSignal.notify_all();
     }
 
-    // Run the remaining tasks on own thread, if needed
-    RunRemainingTasksLoop();
+    // Run the first task on the main thread
+    RunTask(tasks.front());
 
-    // Only returns when there are no more tasks
-    assert(mRemainingTasks.empty());
+    // Help with the remaining tasks
+    RunRemainingTasksLoop(tasks);
 
+    //
     // Wait until all tasks are completed
+    //
+
+    size_t const spinBudget = mSpinBudget.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < spinBudget && mTasksToComplete.load(std::memory_order_acquire) != 0; ++i)
     {
+        spin_wait_pause();
+    }
+
+    if (mTasksToComplete.load(std::memory_order_acquire) != 0)
+    {
+        // Park
         std::unique_lock lock{ mLock };
 
-        if (0 != mTasksToComplete)
-        {
-            // Wait for signal
-            mMainThreadSignal.wait(
-                lock,
-                [this]
-                {
-                    return 0 == mTasksToComplete;
-                });
+        mIsMainThreadParked.store(true);
 
-            assert(0 == mTasksToComplete);
-        }
+        mMainThreadSignal.wait(
+            lock,
+            [this]
+            {
+                return 0 == mTasksToComplete.load();
+            });
+
+        mIsMainThreadParked.store(false);
     }
+
+    //
+    // Close batch, and wait for late workers to notice
+    //
+
+    mIsBatchRunning.store(false);
+
+    while (mActiveWorkers.load() != 0)
+    {
+        spin_wait_pause();
+    }
+
+    mCurrentTasks = nullptr;
 }
 
 void ThreadPool::ThreadLoop(ThreadManager & threadManager)
@@ -127,65 +173,78 @@ void ThreadPool::ThreadLoop(ThreadManager & threadManager)
     // Run thread loop until thread pool is destroyed
     //
 
+    // Not mEpoch.load(): we might be starting after the first batch has been published already
+    std::uint64_t lastEpoch = 0;
+
     while (true)
     {
+        //
+        // Wait for a new batch: spin first...
+        //
+
+        std::uint64_t currentEpoch = mEpoch.load(std::memory_order_acquire);
+
+        size_t const spinBudget = mSpinBudget.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < spinBudget && currentEpoch == lastEpoch && !mIsStop.load(std::memory_order_relaxed); ++i)
+        {
+            spin_wait_pause();
+            currentEpoch = mEpoch.load(std::memory_order_acquire);
+        }
+
+        // ...then park
+        if (currentEpoch == lastEpoch)
         {
             std::unique_lock lock{ mLock };
 
-            if (mIsStop)
-            {
-                // We're done!
-                break;
-            }
+            ++mParkedWorkers;
 
-            // Wait for signal
             mWorkerThreadSignal.wait(
                 lock,
-                [this]
+                [this, lastEpoch]
                 {
-                    return mIsStop || !mRemainingTasks.empty();
+                    return mIsStop.load() || mEpoch.load() != lastEpoch;
                 });
 
-            if (mIsStop)
-            {
-                // We're done!
-                break;
-            }
+            --mParkedWorkers;
+
+            currentEpoch = mEpoch.load(std::memory_order_acquire);
         }
 
-        // Tasks have been queued...
+        if (mIsStop.load())
+        {
+            // We're done!
+            break;
+        }
+
+        lastEpoch = currentEpoch;
+
+        //
+        // Join the batch, unless it's over already
+        //
 
-        // ...run the remaining tasks
-        RunRemainingTasksLoop();
+        ++mActiveWorkers;
+
+        if (mIsBatchRunning.load() && mEpoch.load() == currentEpoch)
+        {
+            RunRemainingTasksLoop(*mCurrentTasks);
+        }
+
+        --mActiveWorkers;
     }
 
     LogMessage("Thread exiting");
 }
 
-void ThreadPool::RunRemainingTasksLoop()
+void ThreadPool::RunRemainingTasksLoop(std::vector<Task> const & tasks)
 {
     //
-    // Run tasks until queue is empty
+    // Run tasks until there are no more tasks to pick
     //
 
     while (true)
     {
-        //
-        // De-queue a task
-        //
-
-        Task const * task = nullptr;
-        {
-            std::unique_lock const lock{ mLock };
-
-            if (!mRemainingTasks.empty())
-            {
-                task = mRemainingTasks.front();
-                mRemainingTasks.pop_front();
-            }
-        }
-
-        if (task == nullptr)
+        size_t const taskIndex = mNextTaskIndex.fetch_add(1, std::memory_order_relaxed);
+        if (taskIndex >= tasks.size())
         {
             // No more tasks
             return;
@@ -195,23 +254,23 @@ void ThreadPool::RunRemainingTasksLoop()
         // Run the task
         //
 
-        RunTask(*task);
+        RunTask(tasks[taskIndex]);
 
         //
         // Signal task completion
         //
 
+        if (mTasksToComplete.fetch_sub(1) == 1)
         {
-            std::unique_lock const lock{ mLock };
-
-            assert(mTasksToComplete > 0);
+            // All tasks completed...
 
-            --mTasksToComplete;
-            if (0 == mTasksToComplete)
+            // ...signal main thread, if it's parked
+            if (mIsMainThreadParked.load())
             {
-                // All tasks completed...
+                {
+                    std::unique_lock const lock{ mLock };
+                }
 
-                // ...signal main thread
                 mMainThreadSignal.notify_all();
             }
         }
@@ -232,4 +291,4 @@ void ThreadPool::RunTask(Task const & task)
 
         // Keep going...
     }
-}
\ No newline at end of file
+}
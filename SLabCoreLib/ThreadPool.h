@@ -7,17 +7,24 @@
 
 #include "ThreadManager.h"
 
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <mutex>
-#include <deque>
 #include <thread>
 #include <vector>
 
 /*
  * This class implements a thread pool that executes batches of tasks.
  *
+ * Batches are run as fork/join regions: workers pick tasks via an atomic
+ * counter, and in-between batches they spin on an epoch variable for a
+ * (configurable) budget, after which they park on a condition variable.
+ * Spinning makes short (sub-100us) parallel regions profitable, as long
+ * as batches follow each other closely; parking avoids burning cores
+ * when they don't.
  */
 class ThreadPool final
 {
@@ -25,11 +32,15 @@ public:
 
     using Task = std::function<void()>;
 
+    // Default number of spin-wait iterations before parking
+    static size_t constexpr DefaultSpinBudget = 4096;
+
 public:
 
     explicit ThreadPool(
         size_t parallelism,
-        ThreadManager & threadManager);
+        ThreadManager & threadManager,
+        size_t spinBudget = DefaultSpinBudget);
 
     ~ThreadPool();
 
@@ -38,8 +49,25 @@ public:
         return mThreads.size() + 1;
     }
 
+    size_t GetSpinBudget() const
+    {
+        return mSpinBudget.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Zero makes threads park immediately.
+     */
+    void SetSpinBudget(size_t spinBudget)
+    {
+        mSpinBudget.store(spinBudget, std::memory_order_relaxed);
+    }
+
     /*
      * The first task is guaranteed to run on the main thread.
+     *
+     * There may be no more tasks than the pool's parallelism; hence each task
+     * gets a thread of its own as soon as it's published, and tasks may
+     * synchronize with each other (e.g. via a ThreadBarrier).
      */
     void Run(std::vector<Task> const & tasks);
 
@@ -56,31 +84,61 @@ private:
 
     void ThreadLoop(ThreadManager & threadManager);
 
-    void RunRemainingTasksLoop();
+    void RunRemainingTasksLoop(std::vector<Task> const & tasks);
 
     void RunTask(Task const & task);
 
 private:
 
-    // Our thread lock
-    std::mutex mLock;
-
     // Our threads
     std::vector<std::thread> mThreads;
 
+    //
+    // Current batch
+    //
+
+    // The tasks of the current batch; only written by the main thread
+    // while no workers are active
+    std::vector<Task> const * mCurrentTasks;
+
+    // The index of the next task to be picked up
+    std::atomic<size_t> mNextTaskIndex;
+
+    // The number of tasks awaiting for completion
+    std::atomic<size_t> mTasksToComplete;
+
+    // Incremented at each batch; workers wait for it to change
+    std::atomic<std::uint64_t> mEpoch;
+
+    // True while the main thread is in a batch; together with mActiveWorkers,
+    // guarantees that no worker may still be picking tasks from a batch
+    // once the main thread leaves Run()
+    std::atomic<bool> mIsBatchRunning;
+
+    // The number of workers currently picking tasks
+    std::atomic<size_t> mActiveWorkers;
+
+    //
+    // Parking
+    //
+
+    std::atomic<size_t> mSpinBudget;
+
+    // Our thread lock, only used for parking
+    std::mutex mLock;
+
     // The condition variable to wake up threads
     std::condition_variable mWorkerThreadSignal;
 
     // The condition variable to wake up the main thread
     std::condition_variable mMainThreadSignal;
 
-    // The tasks currently awaiting to be picked up;
-    // expected to be empty at each Run invocation
-    std::deque<Task const *> mRemainingTasks;
+    // The number of workers parked on mWorkerThreadSignal
+    std::atomic<size_t> mParkedWorkers;
 
-    // The number of tasks awaiting for completion
-    size_t mTasksToComplete;
+    // Set while the main thread is parked on mMainThreadSignal
+    std::atomic<bool> mIsMainThreadParked;
 
     // Set to true when have to stop
-    bool mIsStop;
+    std::atomic<bool> mIsStop;
 };
@@ -0,0 +1,75 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2026-10-16
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Lock-free hand-over of values from one producer thread to one consumer thread.
+ *
+ * The producer fills its own buffer and publishes it, swapping it with the
+ * shared buffer; the consumer, when it wants the latest value, swaps its own
+ * buffer with the shared one if the latter has been published after its last
+ * acquisition. Neither side ever waits for the other, and the consumer always
+ * sees the most recently published value; values published in-between
+ * acquisitions are dropped.
+ */
+template<typename TValue>
+class TripleBuffer
+{
+public:
+
+    TripleBuffer()
+        : mBuffers()
+        , mProducerIndex(0)
+        , mShared(1)
+        , mConsumerIndex(2)
+    {}
+
+    TripleBuffer(TripleBuffer const & other) = delete;
+    TripleBuffer & operator=(TripleBuffer const & other) = delete;
+
+    //
+    // Producer
+    //
+
+    TValue & GetProducerBuffer()
+    {
+        return mBuffers[mProducerIndex];
+    }
+
+    void Publish()
+    {
+        mProducerIndex = mShared.exchange(mProducerIndex | FreshFlag, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    //
+    // Consumer
+    //
+
+    TValue const & AcquireLatest()
+    {
+        if ((mShared.load(std::memory_order_relaxed) & FreshFlag) != 0)
+        {
+            mConsumerIndex = mShared.exchange(mConsumerIndex, std::memory_order_acq_rel) & IndexMask;
+        }
+
+        return mBuffers[mConsumerIndex];
+    }
+
+private:
+
+    static std::uint8_t constexpr IndexMask = 0x03;
+    static std::uint8_t constexpr FreshFlag = 0x04;
+
+    std::array<TValue, 3> mBuffers;
+
+    std::uint8_t mProducerIndex; // Only touched by producer
+    std::atomic<std::uint8_t> mShared; // Index, and whether published after last acquisition
+    std::uint8_t mConsumerIndex; // Only touched by consumer
+};
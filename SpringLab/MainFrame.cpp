@@ -869,6 +869,20 @@ void MainFrame::OnSimulationTimer(wxTimerEvent & /*event*/)
 
     assert(!!mSimulationController);
 
+    // When fast-playing, let the simulation run on its own thread - if we can afford one
+    bool const doRunSimulationThread =
+        mSimulationControlState == SimulationControlStateType::FastPlay
+        && mSimulationController->IsSimulationThreadSupported();
+
+    if (doRunSimulationThread && !mSimulationController->IsSimulationThreadRunning())
+    {
+        mSimulationController->StartSimulationThread();
+    }
+    else if (!doRunSimulationThread && mSimulationController->IsSimulationThreadRunning())
+    {
+        mSimulationController->StopSimulationThread();
+    }
+
     auto constexpr SlowPlayInterval = std::chrono::milliseconds(500);
 
     if (auto const now = std::chrono::steady_clock::now();
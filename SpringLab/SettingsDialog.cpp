@@ -258,6 +258,18 @@ void SettingsDialog::Open()
 
 ////////////////////////////////////////////////////////////
 
+void SettingsDialog::OnCommonDoFuseEnergyObservationCheckBoxClick(wxCommandEvent & event)
+{
+    mLiveSettings.SetValue(SLabSettings::CommonDoFuseEnergyObservation, event.IsChecked());
+    OnLiveSettingsChanged();
+}
+
+void SettingsDialog::OnFastMSSSimulatorDoUseNestedDissectionOrderingCheckBoxClick(wxCommandEvent & event)
+{
+    mLiveSettings.SetValue(SLabSettings::FastMSSSimulatorDoUseNestedDissectionOrdering, event.IsChecked());
+    OnLiveSettingsChanged();
+}
+
 void SettingsDialog::OnDoRenderAssignedParticleForcesCheckBoxClick(wxCommandEvent & event)
 {
     mLiveSettings.SetValue(SLabSettings::DoRenderAssignedParticleForces, event.IsChecked());
@@ -523,6 +535,69 @@ void SettingsDialog::PopulateCommonSimulatorPanel(wxPanel * panel)
             CellBorder);
     }
 
+    // Observation
+    {
+        wxStaticBox * observationBox = new wxStaticBox(panel, wxID_ANY, _("Observation"));
+
+        wxBoxSizer * observationBoxSizer = new wxBoxSizer(wxVERTICAL);
+        observationBoxSizer->AddSpacer(StaticBoxTopMargin);
+
+        {
+            wxGridBagSizer * observationSizer = new wxGridBagSizer(0, 0);
+
+            // Observation Interval
+            {
+                mObservationIntervalSlider = new SliderControl<size_t>(
+                    observationBox,
+                    SliderWidth,
+                    SliderHeight,
+                    "Observation Interval",
+                    "The number of simulation updates between two consecutive measurements of the object's energies and bending.",
+                    [this](size_t value)
+                    {
+                        this->mLiveSettings.SetValue(SLabSettings::ObservationInterval, value);
+                        this->OnLiveSettingsChanged();
+                    },
+                    std::make_unique<IntegralLinearSliderCore<size_t>>(
+                        mSimulationController->GetMinObservationInterval(),
+                        mSimulationController->GetMaxObservationInterval()));
+
+                observationSizer->Add(
+                    mObservationIntervalSlider,
+                    wxGBPosition(0, 0),
+                    wxGBSpan(1, 1),
+                    wxEXPAND | wxALL,
+                    CellBorder);
+            }
+
+            // Fuse Energy Observation
+            {
+                mCommonDoFuseEnergyObservationCheckBox = new wxCheckBox(observationBox, wxID_ANY,
+                    _("Fuse Energy Observation"), wxDefaultPosition, wxDefaultSize);
+                mCommonDoFuseEnergyObservationCheckBox->SetToolTip("Has simulators that support it calculate energies while updating the object, rather than after each update. Potential energy then lags one step behind.");
+                mCommonDoFuseEnergyObservationCheckBox->Bind(wxEVT_COMMAND_CHECKBOX_CLICKED, &SettingsDialog::OnCommonDoFuseEnergyObservationCheckBoxClick, this);
+
+                observationSizer->Add(
+                    mCommonDoFuseEnergyObservationCheckBox,
+                    wxGBPosition(0, 1),
+                    wxGBSpan(1, 1),
+                    wxALL | wxALIGN_CENTER_VERTICAL,
+                    CellBorder);
+            }
+
+            observationBoxSizer->Add(observationSizer, 0, wxALL, StaticBoxInsetMargin);
+        }
+
+        observationBox->SetSizerAndFit(observationBoxSizer);
+
+        gridSizer->Add(
+            observationBox,
+            wxGBPosition(0, 5),
+            wxGBSpan(1, 1),
+            wxEXPAND | wxALL | wxALIGN_CENTER_HORIZONTAL,
+            CellBorder);
+    }
+
 
     // Finalize panel
 
@@ -867,6 +942,21 @@ void SettingsDialog::PopulateFastMSSSimulatorPanel(wxPanel * panel)
                     CellBorder);
             }
 
+            // Nested Dissection Ordering
+            {
+                mFastMSSSimulatorDoUseNestedDissectionOrderingCheckBox = new wxCheckBox(mechanicsBox, wxID_ANY,
+                    _("Nested Dissection Ordering"), wxDefaultPosition, wxDefaultSize);
+                mFastMSSSimulatorDoUseNestedDissectionOrderingCheckBox->SetToolTip("Orders the system matrix with nested dissection, rather than with approximate minimum degree.");
+                mFastMSSSimulatorDoUseNestedDissectionOrderingCheckBox->Bind(wxEVT_COMMAND_CHECKBOX_CLICKED, &SettingsDialog::OnFastMSSSimulatorDoUseNestedDissectionOrderingCheckBoxClick, this);
+
+                mechanicsSizer->Add(
+                    mFastMSSSimulatorDoUseNestedDissectionOrderingCheckBox,
+                    wxGBPosition(0, 3),
+                    wxGBSpan(1, 1),
+                    wxALL | wxALIGN_CENTER_VERTICAL,
+                    CellBorder);
+            }
+
             mechanicsBoxSizer->Add(mechanicsSizer, 0, wxALL, StaticBoxInsetMargin);
         }
 
@@ -1138,6 +1228,31 @@ void SettingsDialog::PopulatePositionBasedSimulatorPanel(wxPanel * panel)
                     CellBorder);
             }
 
+            // XPBD Spring Stiffness
+            {
+                mPositionBasedSimulatorXPBDSpringStiffnessSlider = new SliderControl<float>(
+                    mechanicsBox,
+                    SliderWidth,
+                    SliderHeight,
+                    "XPBD Spring Stiffness",
+                    "Adjusts the stiffness of springs in the XPBD simulator.",
+                    [this](float value)
+                    {
+                        this->mLiveSettings.SetValue(SLabSettings::PositionBasedSimulatorXPBDSpringStiffnessCoefficient, value);
+                        this->OnLiveSettingsChanged();
+                    },
+                    std::make_unique<LinearSliderCore>(
+                        mSimulationController->GetPositionBasedSimulatorMinXPBDSpringStiffnessCoefficient(),
+                        mSimulationController->GetPositionBasedSimulatorMaxXPBDSpringStiffnessCoefficient()));
+
+                mechanicsSizer->Add(
+                    mPositionBasedSimulatorXPBDSpringStiffnessSlider,
+                    wxGBPosition(0, 4),
+                    wxGBSpan(1, 1),
+                    wxEXPAND | wxALL,
+                    CellBorder);
+            }
+
             mechanicsBoxSizer->Add(mechanicsSizer, 0, wxALL, StaticBoxInsetMargin);
         }
 
@@ -1213,6 +1328,8 @@ void SettingsDialog::SyncControlsWithSettings(Settings<SLabSettings> const & set
     mCommonMassAdjustmentSlider->SetValue(settings.GetValue<float>(SLabSettings::CommonMassAdjustment));
     mCommonGravityAdjustmentSlider->SetValue(settings.GetValue<float>(SLabSettings::CommonGravityAdjustment));    
     mNumberOfSimulationThreadsSlider->SetValue(settings.GetValue<size_t>(SLabSettings::NumberOfSimulationThreads));
+    mObservationIntervalSlider->SetValue(settings.GetValue<size_t>(SLabSettings::ObservationInterval));
+    mCommonDoFuseEnergyObservationCheckBox->SetValue(settings.GetValue<bool>(SLabSettings::CommonDoFuseEnergyObservation));
 
     // Classic
     mClassicSimulatorSpringStiffnessSlider->SetValue(settings.GetValue<float>(SLabSettings::ClassicSimulatorSpringStiffnessCoefficient));
@@ -1229,12 +1346,14 @@ void SettingsDialog::SyncControlsWithSettings(Settings<SLabSettings> const & set
     mPositionBasedSimulatorNumUpdateIterationsSlider->SetValue(settings.GetValue<size_t>(SLabSettings::PositionBasedSimulatorNumUpdateIterations));
     mPositionBasedSimulatorNumSolverIterationsSlider->SetValue(settings.GetValue<size_t>(SLabSettings::PositionBasedSimulatorNumSolverIterations));
     mPositionBasedSimulatorSpringStiffnessSlider->SetValue(settings.GetValue<float>(SLabSettings::PositionBasedSimulatorSpringStiffness));
+    mPositionBasedSimulatorXPBDSpringStiffnessSlider->SetValue(settings.GetValue<float>(SLabSettings::PositionBasedSimulatorXPBDSpringStiffnessCoefficient));
     mPositionBasedSimulatorGlobalDampingSlider->SetValue(settings.GetValue<float>(SLabSettings::PositionBasedSimulatorGlobalDamping));
 
     // FastMSS
     mFastMSSSimulatorNumLocalGlobalStepIterationsSlider->SetValue(settings.GetValue<size_t>(SLabSettings::FastMSSSimulatorNumLocalGlobalStepIterations));
     mFastMSSSimulatorSpringStiffnessSlider->SetValue(settings.GetValue<float>(SLabSettings::FastMSSSimulatorSpringStiffnessCoefficient));
     mFastMSSSimulatorGlobalDampingSlider->SetValue(settings.GetValue<float>(SLabSettings::FastMSSSimulatorGlobalDamping));
+    mFastMSSSimulatorDoUseNestedDissectionOrderingCheckBox->SetValue(settings.GetValue<bool>(SLabSettings::FastMSSSimulatorDoUseNestedDissectionOrdering));
 
     // Gauss-Seidel
     mGaussSeidelSimulatorNumMechanicalDynamicsIterationsSlider->SetValue(settings.GetValue<size_t>(SLabSettings::GaussSeidelSimulatorNumMechanicalDynamicsIterations));
@@ -34,6 +34,8 @@ public:
 
 private:
 
+    void OnCommonDoFuseEnergyObservationCheckBoxClick(wxCommandEvent & event);
+    void OnFastMSSSimulatorDoUseNestedDissectionOrderingCheckBoxClick(wxCommandEvent & event);
     void OnDoRenderAssignedParticleForcesCheckBoxClick(wxCommandEvent & event);
 
 	void OnRevertToDefaultsButton(wxCommandEvent& event);
@@ -54,6 +56,8 @@ private:
     SliderControl<float> * mCommonMassAdjustmentSlider;
     SliderControl<float> * mCommonGravityAdjustmentSlider;
     SliderControl<size_t> * mNumberOfSimulationThreadsSlider;
+    SliderControl<size_t> * mObservationIntervalSlider;
+    wxCheckBox * mCommonDoFuseEnergyObservationCheckBox;
 
     // Classic
     SliderControl<float> * mClassicSimulatorSpringStiffnessSlider;
@@ -70,12 +74,14 @@ private:
     SliderControl<size_t> * mPositionBasedSimulatorNumUpdateIterationsSlider;
     SliderControl<size_t> * mPositionBasedSimulatorNumSolverIterationsSlider;
     SliderControl<float> * mPositionBasedSimulatorSpringStiffnessSlider;
+    SliderControl<float> * mPositionBasedSimulatorXPBDSpringStiffnessSlider;
     SliderControl<float> * mPositionBasedSimulatorGlobalDampingSlider;
 
     // FastMSS
     SliderControl<size_t> * mFastMSSSimulatorNumLocalGlobalStepIterationsSlider;
     SliderControl<float> * mFastMSSSimulatorSpringStiffnessSlider;
     SliderControl<float> * mFastMSSSimulatorGlobalDampingSlider;
+    wxCheckBox * mFastMSSSimulatorDoUseNestedDissectionOrderingCheckBox;
 
     // GaussSeidel
     SliderControl<size_t> * mGaussSeidelSimulatorNumMechanicalDynamicsIterationsSlider;
@@ -26,6 +26,7 @@ BaseSettingsManager<SLabSettings>::BaseSettingsManagerFactory SettingsManager::M
     ADD_SETTING(float, CommonSimulationTimeStepDuration);
     ADD_SETTING(float, CommonMassAdjustment);
     ADD_SETTING(float, CommonGravityAdjustment);    
+    ADD_SETTING(bool, CommonDoFuseEnergyObservation);
 
     ADD_SETTING(float, ClassicSimulatorSpringStiffnessCoefficient);
     ADD_SETTING(float, ClassicSimulatorSpringDampingCoefficient);
@@ -39,11 +40,13 @@ BaseSettingsManager<SLabSettings>::BaseSettingsManagerFactory SettingsManager::M
     ADD_SETTING(size_t, PositionBasedSimulatorNumUpdateIterations);
     ADD_SETTING(size_t, PositionBasedSimulatorNumSolverIterations);
     ADD_SETTING(float, PositionBasedSimulatorSpringStiffness);
+    ADD_SETTING(float, PositionBasedSimulatorXPBDSpringStiffnessCoefficient);
     ADD_SETTING(float, PositionBasedSimulatorGlobalDamping);
 
     ADD_SETTING(size_t, FastMSSSimulatorNumLocalGlobalStepIterations);
     ADD_SETTING(float, FastMSSSimulatorSpringStiffnessCoefficient);
     ADD_SETTING(float, FastMSSSimulatorGlobalDamping);
+    ADD_SETTING(bool, FastMSSSimulatorDoUseNestedDissectionOrdering);
 
     ADD_SETTING(size_t, GaussSeidelSimulatorNumMechanicalDynamicsIterations);
     ADD_SETTING(float, GaussSeidelSimulatorSpringReductionFraction);
@@ -53,6 +56,7 @@ BaseSettingsManager<SLabSettings>::BaseSettingsManagerFactory SettingsManager::M
     ADD_SETTING(size_t, NumberOfSimulationThreads);
 
     ADD_SETTING(bool, DoRenderAssignedParticleForces);
+    ADD_SETTING(size_t, ObservationInterval);
 
     return factory;
 }
@@ -13,6 +13,7 @@ enum class SLabSettings : size_t
     CommonSimulationTimeStepDuration = 0,
     CommonMassAdjustment,
     CommonGravityAdjustment,    
+    CommonDoFuseEnergyObservation,
 
     ClassicSimulatorSpringStiffnessCoefficient,
     ClassicSimulatorSpringDampingCoefficient,
@@ -26,11 +27,13 @@ enum class SLabSettings : size_t
     PositionBasedSimulatorNumUpdateIterations,
     PositionBasedSimulatorNumSolverIterations,
     PositionBasedSimulatorSpringStiffness,
+    PositionBasedSimulatorXPBDSpringStiffnessCoefficient,
     PositionBasedSimulatorGlobalDamping,
 
     FastMSSSimulatorNumLocalGlobalStepIterations,
     FastMSSSimulatorSpringStiffnessCoefficient,
     FastMSSSimulatorGlobalDamping,
+    FastMSSSimulatorDoUseNestedDissectionOrdering,
 
     GaussSeidelSimulatorNumMechanicalDynamicsIterations,
     GaussSeidelSimulatorSpringReductionFraction,
@@ -40,8 +43,9 @@ enum class SLabSettings : size_t
     NumberOfSimulationThreads,
 
     DoRenderAssignedParticleForces,    
+    ObservationInterval,
 
-    _Last = DoRenderAssignedParticleForces
+    _Last = ObservationInterval
 };
 
 class SettingsManager final : public BaseSettingsManager<SLabSettings>
@@ -0,0 +1,266 @@
+/***************************************************************************************
+ * Original Author:     Gabriele Giuseppini
+ * Created:             2026-10-16
+ * Copyright:           Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+//
+// The headless application: runs a simulation as fast as possible, without
+// a GUI and without an OpenGL context, and reports timings and measurements.
+//
+
+#include <SLabCoreLib/FloatingPoint.h>
+#include <SLabCoreLib/ISimulationEventHandler.h>
+#include <SLabCoreLib/SimulationController.h>
+#include <SLabCoreLib/SLabException.h>
+#include <SLabCoreLib/Simulator/Common/SimulatorRegistry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace /* anonymous */ {
+
+    struct Options
+    {
+        std::string SimulatorName{ SimulatorRegistry::GetDefaultSimulatorTypeName() };
+        std::optional<std::string> ObjectDefinitionFilePath;
+        size_t NumSyntheticSprings{ 10000 };
+        size_t NumSteps{ 1000 };
+        size_t NumThreads{ 1 };
+        bool DoPrintSteps{ true };
+    };
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: SpringLabHeadless [options]" << std::endl;
+        std::cout << "  --simulator <name>       Simulator to run (default: \"" << SimulatorRegistry::GetDefaultSimulatorTypeName() << "\")" << std::endl;
+        std::cout << "  --object <path>          Object definition (.png) to load" << std::endl;
+        std::cout << "  --synthetic <springs>    Synthetic object with the specified number of springs (default: 10000)" << std::endl;
+        std::cout << "  --steps <count>          Number of simulation steps to run (default: 1000)" << std::endl;
+        std::cout << "  --threads <count>        Simulation parallelism (default: 1)" << std::endl;
+        std::cout << "  --no-steps               Only print the final summary" << std::endl;
+        std::cout << "  --list                   List available simulators" << std::endl;
+    }
+
+    std::optional<Options> ParseOptions(int argc, char ** argv)
+    {
+        Options options;
+
+        for (int a = 1; a < argc; ++a)
+        {
+            std::string const arg(argv[a]);
+
+            auto const getValue = [&]() -> std::string
+            {
+                if (a + 1 >= argc)
+                {
+                    throw SLabException("Missing value for option \"" + arg + "\"");
+                }
+
+                return std::string(argv[++a]);
+            };
+
+            if (arg == "--simulator")
+            {
+                options.SimulatorName = getValue();
+            }
+            else if (arg == "--object")
+            {
+                options.ObjectDefinitionFilePath = getValue();
+            }
+            else if (arg == "--synthetic")
+            {
+                options.NumSyntheticSprings = std::stoul(getValue());
+            }
+            else if (arg == "--steps")
+            {
+                options.NumSteps = std::stoul(getValue());
+            }
+            else if (arg == "--threads")
+            {
+                options.NumThreads = std::stoul(getValue());
+            }
+            else if (arg == "--no-steps")
+            {
+                options.DoPrintSteps = false;
+            }
+            else if (arg == "--list")
+            {
+                for (auto const & simulatorName : SimulatorRegistry::GetSimulatorTypeNames())
+                {
+                    std::cout << simulatorName << std::endl;
+                }
+
+                return std::nullopt;
+            }
+            else
+            {
+                PrintUsage();
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+
+    class MeasurementCollector final : public ISimulationEventHandler
+    {
+    public:
+
+        explicit MeasurementCollector(bool doPrintSteps)
+            : mDoPrintSteps(doPrintSteps)
+            , mStepCount(0)
+        {}
+
+        void OnMeasurement(
+            float totalKineticEnergy,
+            float totalPotentialEnergy,
+            std::optional<float> bending,
+            std::chrono::nanoseconds lastSimulationDuration,
+            std::chrono::nanoseconds avgSimulationDuration) override
+        {
+            ++mStepCount;
+
+            TotalKineticEnergy = totalKineticEnergy;
+            TotalPotentialEnergy = totalPotentialEnergy;
+            Bending = bending;
+            AvgSimulationDuration = avgSimulationDuration;
+
+            if (mDoPrintSteps)
+            {
+                std::printf("%zu,%.3f,%f,%f,%s\n",
+                    mStepCount,
+                    static_cast<double>(lastSimulationDuration.count()) / 1000.0,
+                    totalKineticEnergy,
+                    totalPotentialEnergy,
+                    bending ? std::to_string(*bending).c_str() : "");
+            }
+        }
+
+        float TotalKineticEnergy{ 0.0f };
+        float TotalPotentialEnergy{ 0.0f };
+        std::optional<float> Bending;
+        std::chrono::nanoseconds AvgSimulationDuration{ 0 };
+
+    private:
+
+        bool const mDoPrintSteps;
+        size_t mStepCount;
+    };
+}
+
+int main(int argc, char ** argv)
+{
+    //
+    // Initialize floating point handling
+    //
+
+    // Avoid denormal numbers for very small quantities
+    EnableFloatingPointFlushToZero();
+
+#ifdef FLOATING_POINT_CHECKS
+    EnableFloatingPointExceptions();
+#endif
+
+    try
+    {
+        auto const options = ParseOptions(argc, argv);
+        if (!options)
+        {
+            return 0;
+        }
+
+        auto const & simulatorNames = SimulatorRegistry::GetSimulatorTypeNames();
+        if (std::find(simulatorNames.cbegin(), simulatorNames.cend(), options->SimulatorName) == simulatorNames.cend())
+        {
+            throw SLabException("Unknown simulator \"" + options->SimulatorName + "\"; use --list to list the available simulators");
+        }
+
+        //
+        // Create controller
+        //
+
+        std::unique_ptr<SimulationController> simulationController = SimulationController::CreateHeadless();
+
+        MeasurementCollector measurementCollector(options->DoPrintSteps);
+        simulationController->RegisterEventHandler(&measurementCollector);
+
+        if (options->NumThreads < simulationController->GetMinNumberOfSimulationThreads()
+            || options->NumThreads > simulationController->GetMaxNumberOfSimulationThreads())
+        {
+            throw SLabException("Number of threads must be between " + std::to_string(simulationController->GetMinNumberOfSimulationThreads())
+                + " and " + std::to_string(simulationController->GetMaxNumberOfSimulationThreads()));
+        }
+
+        simulationController->SetNumberOfSimulationThreads(options->NumThreads);
+
+        //
+        // Load object
+        //
+
+        // Set simulator first, as the object's layout depends on it
+        simulationController->SetSimulator(options->SimulatorName);
+
+        if (options->ObjectDefinitionFilePath)
+        {
+            simulationController->LoadObject(*(options->ObjectDefinitionFilePath));
+        }
+        else
+        {
+            simulationController->MakeObject(options->NumSyntheticSprings);
+        }
+
+        //
+        // Run
+        //
+
+        if (options->DoPrintSteps)
+        {
+            std::printf("step,duration_us,kinetic_energy,potential_energy,bending\n");
+        }
+
+        auto const startTimestamp = std::chrono::steady_clock::now();
+
+        for (size_t s = 0; s < options->NumSteps; ++s)
+        {
+            simulationController->UpdateSimulation();
+        }
+
+        auto const totalDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimestamp);
+
+        //
+        // Report
+        //
+
+        std::printf("Simulator:              %s\n", simulationController->GetCurrentSimulatorTypeName().c_str());
+        std::printf("Threads:                %zu\n", simulationController->GetNumberOfSimulationThreads());
+        std::printf("Steps:                  %zu\n", options->NumSteps);
+        std::printf("Simulation time:        %f s\n", simulationController->GetCurrentSimulationTime());
+        std::printf("Total wall time:        %.3f ms\n", static_cast<double>(totalDuration.count()) / 1000.0);
+        std::printf("Avg update duration:    %.3f us\n", static_cast<double>(measurementCollector.AvgSimulationDuration.count()) / 1000.0);
+        std::printf("Steps/s:                %.1f\n", totalDuration.count() > 0 ? static_cast<double>(options->NumSteps) * 1000000.0 / static_cast<double>(totalDuration.count()) : 0.0);
+        std::printf("Total kinetic energy:   %f\n", measurementCollector.TotalKineticEnergy);
+        std::printf("Total potential energy: %f\n", measurementCollector.TotalPotentialEnergy);
+        if (measurementCollector.Bending)
+        {
+            std::printf("Bending:                %f\n", *(measurementCollector.Bending));
+        }
+        else
+        {
+            std::printf("Bending:                n/a (object has no bending probe)\n");
+        }
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}